@@ -1,10 +1,11 @@
 #ifndef AST_H
 #define AST_H
 
-#include <map>
 #include <string>
 #include <vector>
 #include <memory>
+#include <Common/Interner.h>
+#include <AST/NodeArena.h>
 #include <AST/NameNode.h>
 #include <AST/Statement.h>
 #include <AST/Identifier.h>
@@ -12,11 +13,20 @@
 namespace dmp {
 
     struct AST {
-        std::map<std::string, std::shared_ptr<NameNode> > representations;
-        std::map<std::string, std::shared_ptr<NameNode> > declarations;
-        std::map<std::string, std::shared_ptr<DefineStatement> > definitions;
 
-        std::shared_ptr<Node> getNonSynonymRepNode(const std::shared_ptr<Identifier>&);
+        NodeArena arena;
+
+        SymbolMap<NameNode*> representations;
+        SymbolMap<NameNode*> declarations;
+        SymbolMap<DefineStatement*> definitions;
+
+        Node* getNonSynonymRepNode(Identifier*);
+
+        template<typename T, typename... Args>
+        T* make(Args&&... args) {
+            return arena.make<T>(std::forward<Args>(args)...);
+        }
+
     };
 
 }
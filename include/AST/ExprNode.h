@@ -2,9 +2,11 @@
 #define EXPRNODE_H
 
 #include <map>
+#include <array>
 #include <vector>
 #include <memory>
 #include <AST/Node.h>
+#include <Lexer/TokenID.h>
 
 namespace dmp {
 
@@ -67,12 +69,46 @@ namespace dmp {
         ASSIGNOP_BIT_LEFT_ASSIGN
     };
 
+    /*
+
+    Operator table, indexed by token ID (offset by TOKEN_NONE)
+
+    For every token that can act as an operator, the table holds the kind(s) of operator it can be, 
+    the AST op it maps to as a prefix unary, binary or assignment operator, and the binding power 
+    (precedence and associativity) used by the expression parser when the token appears between two operands. 
+    Assignments bind the weakest, and are the only right-associative operators. 
+
+    */
+
+    enum Op_Kind_ID {
+
+        OPKIND_UNARY  = 1,
+        OPKIND_BINARY = 2,
+        OPKIND_ASSIGN = 4
+
+    };
+
+    enum Assoc_ID {
+
+        ASSOC_LEFT,
+        ASSOC_RIGHT
+
+    };
+
+    struct OperatorInfo {
+
+        uint16_t kind;
+        uint16_t unop;
+        uint16_t binop;
+        uint16_t assop;
+        uint16_t assoc;
+        int prec;
+
+    };
+
     struct ExprNode : public Node {
 
-        static std::map<int, int> prec;
-        static std::map<int, uint16_t> unopsmap;
-        static std::map<int, uint16_t> binopsmap;
-        static std::map<int, uint16_t> assopsmap;
+        static const std::array<OperatorInfo, TOKEN_NTOKENS - TOKEN_NONE> optable;
         static std::map<uint16_t, std::string> unopstrmap;
         static std::map<uint16_t, std::string> binopstrmap;
         static std::map<uint16_t, std::string> assopstrmap;
@@ -83,16 +119,32 @@ namespace dmp {
 
         virtual ~ExprNode() = default;
 
+        static inline const OperatorInfo& operatorInfo(int t) {
+            return optable[t > TOKEN_NONE && t < TOKEN_NTOKENS ? t - TOKEN_NONE : 0];
+        }
+
+        static inline bool isUnop(int t) {
+            return (operatorInfo(t).kind & OPKIND_UNARY) != 0;
+        }
+
+        static inline bool isBinop(int t) {
+            return (operatorInfo(t).kind & OPKIND_BINARY) != 0;
+        }
+
+        static inline bool isAssop(int t) {
+            return (operatorInfo(t).kind & OPKIND_ASSIGN) != 0;
+        }
+
         static inline uint16_t unopFromToken(int t) {
-            return unopsmap[t];
+            return operatorInfo(t).unop;
         }
 
         static inline uint16_t binopFromToken(int t) {
-            return binopsmap[t];
+            return operatorInfo(t).binop;
         }
 
         static inline uint16_t assopFromToken(int t) {
-            return assopsmap[t];
+            return operatorInfo(t).assop;
         }
 
         static inline std::string unopstring(uint16_t o) {
@@ -108,7 +160,11 @@ namespace dmp {
         }
 
         static inline int precedence(int t) {
-            return prec[t];
+            return operatorInfo(t).prec;
+        }
+
+        static inline uint16_t associativity(int t) {
+            return operatorInfo(t).assoc;
         }
 
         inline bool isLiteralNode() {
@@ -119,36 +175,36 @@ namespace dmp {
     struct AssignExprNode : public ExprNode {
 
         uint16_t op;
-        std::shared_ptr<Node> lhs;
-        std::shared_ptr<Node> rhs;
+        Node* lhs;
+        Node* rhs;
 
-        AssignExprNode(uint16_t, const std::shared_ptr<Node>&, const std::shared_ptr<Node>&);
+        AssignExprNode(uint16_t, Node*, Node*);
     };
 
     struct BinaryExprNode : public ExprNode {
 
         uint16_t op;
-        std::shared_ptr<Node> lhs;
-        std::shared_ptr<Node> rhs;
+        Node* lhs;
+        Node* rhs;
 
-        BinaryExprNode(uint16_t, const std::shared_ptr<Node>&, const std::shared_ptr<Node>&);
+        BinaryExprNode(uint16_t, Node*, Node*);
 
     };
 
     struct CallExprNode : public ExprNode {
 
-        std::shared_ptr<Node> func;
-        std::vector<std::shared_ptr<Node> > args;
+        Node* func;
+        std::vector<Node*> args;
 
-        CallExprNode(const std::shared_ptr<Node>&, const std::vector<std::shared_ptr<Node> >&);
+        CallExprNode(Node*, const std::vector<Node*>&);
     };
 
     struct UnaryExprNode : public ExprNode {
 
         uint16_t op;
-        std::shared_ptr<Node> exp;
+        Node* exp;
 
-        UnaryExprNode(uint16_t, const std::shared_ptr<Node>&);
+        UnaryExprNode(uint16_t, Node*);
 
     };
 
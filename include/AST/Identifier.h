@@ -10,6 +10,7 @@ namespace dmp {
     struct Identifier : public Node {
 
         std::string name;
+        uint32_t id;
 
         Identifier();
         Identifier(const std::string&, const Location&);
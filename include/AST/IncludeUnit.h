@@ -0,0 +1,66 @@
+#ifndef INCLUDEUNIT_H
+#define INCLUDEUNIT_H
+
+#include <string>
+#include <vector>
+#include <string_view>
+#include <IO/Location.h>
+#include <AST/AST.h>
+#include <AST/Node.h>
+
+namespace dmp {
+
+    /*
+
+    Precompiled form of an include file
+
+    The global units an include file contributes to the AST (representations, declarations and definitions) are
+    recorded while the file is parsed, in order, together with the files it includes in turn. Nested includes are
+    kept as include entries rather than expanded, since what they contribute depends on what the including
+    compilation has already processed.
+
+    The record can be written out as a flat binary blob and read back into another AST without lexing or parsing
+    the file. Nodes are written in pre-order, each one only once; a node that is reached again (e.g. a local variable
+    that is listed among the symbols of its block) is written as a back-reference. Names are stored as strings and
+    interned anew when read. Every node of the record comes from the file itself, so locations are stored without
+    a file index and take the index the file has in the reading compilation.
+
+    format_version must be bumped whenever the layout of the blob (or of any node) changes.
+
+    */
+
+    enum Include_Entry_ID {
+
+        ENTRY_INCLUDE,
+        ENTRY_REPRESENTATION,
+        ENTRY_DECLARATION,
+        ENTRY_DEFINITION
+
+    };
+
+    struct IncludeEntry {
+
+        uint16_t is;
+        std::string filename;
+        Location loc;
+        Node* node;
+
+        IncludeEntry(uint16_t, Node*);
+        IncludeEntry(const std::string&, const Location&);
+
+    };
+
+    struct IncludeUnit {
+
+        static constexpr uint32_t format_version = 1;
+
+        std::vector<IncludeEntry> entries;
+
+        std::string serialize(uint16_t) const;
+        bool deserialize(std::string_view, AST*, uint16_t);
+
+    };
+
+}
+
+#endif
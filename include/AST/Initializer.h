@@ -19,11 +19,11 @@ namespace dmp {
     struct InitElement : public Node {
 
         uint16_t is;
-        std::shared_ptr<Node> tag;
-        std::shared_ptr<Node> value;
+        Node* tag;
+        Node* value;
 
-        InitElement(const std::shared_ptr<Node>&);
-        InitElement(uint16_t, const std::shared_ptr<Node>&, const std::shared_ptr<Node>&);
+        InitElement(Node*);
+        InitElement(uint16_t, Node*, Node*);
 
     };
 
@@ -5,6 +5,7 @@
 #include <string>
 #include <AST/ExprNode.h>
 #include <AST/Token.h>
+#include <AST/NodeArena.h>
 
 namespace dmp {
 
@@ -12,9 +13,9 @@ namespace dmp {
 
         bool literal;
 
-        BoolNode(const std::shared_ptr<Token>&, bool);
+        BoolNode(const Token&, bool);
 
-        static std::shared_ptr<BoolNode> construct(const std::shared_ptr<Token>&);
+        static BoolNode* construct(NodeArena&, const Token&);
 
     };
 
@@ -23,9 +24,9 @@ namespace dmp {
         uint64_t literal;
         std::string str;
 
-        IntNode(const std::shared_ptr<Token>&, uint64_t);
+        IntNode(const Token&, uint64_t);
 
-        static std::shared_ptr<IntNode> construct(const std::shared_ptr<Token>&);
+        static IntNode* construct(NodeArena&, const Token&);
 
     };
 
@@ -34,9 +35,9 @@ namespace dmp {
         double literal;
         std::string str;
 
-        RealNode(const std::shared_ptr<Token>&, double);
+        RealNode(const Token&, double);
 
-        static std::shared_ptr<RealNode> construct(const std::shared_ptr<Token>&);
+        static RealNode* construct(NodeArena&, const Token&);
 
     };
 
@@ -45,9 +46,9 @@ namespace dmp {
         char literal;
         std::string str;
 
-        CharNode(const std::shared_ptr<Token>&, char);
+        CharNode(const Token&, char);
 
-        static std::shared_ptr<CharNode> construct(const std::shared_ptr<Token>&);
+        static CharNode* construct(NodeArena&, const Token&);
 
     };
 
@@ -56,9 +57,9 @@ namespace dmp {
         std::string literal;
         std::string str;
 
-        StringNode(const std::shared_ptr<Token>&, const std::string&);
+        StringNode(const Token&, const std::string&);
 
-        static std::shared_ptr<StringNode> construct(const std::shared_ptr<Token>&);
+        static StringNode* construct(NodeArena&, const Token&);
 
     };
 
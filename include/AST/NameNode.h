@@ -17,15 +17,15 @@ namespace dmp {
 
     struct NameNode : public Node {
 
-        std::shared_ptr<Identifier> name;
-        std::shared_ptr<Node> node;
+        Identifier* name;
+        Node* node;
         uint64_t attr;
 
         NameNode();
-        NameNode(const std::shared_ptr<Node>&);
-        NameNode(const std::shared_ptr<Node>&, uint64_t);
-        NameNode(const std::shared_ptr<Identifier>&, const std::shared_ptr<Node>&);
-        NameNode(const std::shared_ptr<Identifier>&, const std::shared_ptr<Node>&, uint64_t);
+        NameNode(Node*);
+        NameNode(Node*, uint64_t);
+        NameNode(Identifier*, Node*);
+        NameNode(Identifier*, Node*, uint64_t);
 
     };
 
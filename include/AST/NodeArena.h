@@ -0,0 +1,49 @@
+#ifndef NODEARENA_H
+#define NODEARENA_H
+
+#include <new>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <AST/Node.h>
+
+namespace dmp {
+
+    /*
+
+    Bump allocator that owns all the nodes of an AST
+
+    Nodes are constructed in place in large chunks of memory, and are linked to each other through raw pointers.
+    Nothing is freed until the arena itself is destroyed, at which point the destructors of all the nodes are
+    called (in reverse order of construction) and the chunks are released in one go.
+
+    */
+
+    struct NodeArena {
+
+        static constexpr std::size_t chunk_size = 64 * 1024;
+
+        std::vector<std::unique_ptr<char[]> > chunks;
+        std::vector<Node*> nodes;
+        char* next;
+        char* end;
+
+        NodeArena();
+        NodeArena(const NodeArena&) = delete;
+        NodeArena& operator=(const NodeArena&) = delete;
+        ~NodeArena();
+
+        void* allocate(std::size_t, std::size_t);
+
+        template<typename T, typename... Args>
+        T* make(Args&&... args) {
+            T* node = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            nodes.push_back(node);
+            return node;
+        }
+
+    };
+
+}
+
+#endif
@@ -4,6 +4,7 @@
 #include <AST/Node.h>
 #include <AST/Identifier.h>
 #include <AST/ExprNode.h>
+#include <unordered_map>
 
 namespace dmp {
 
@@ -58,54 +59,55 @@ namespace dmp {
 
     struct ReturnStatement : public Statement {
 
-        std::shared_ptr<Node> val;
+        Node* val;
 
-        ReturnStatement(const std::shared_ptr<Node>&);
+        ReturnStatement(Node*);
 
     };
 
     struct CallStatement : public Statement {
 
-        std::shared_ptr<CallExprNode> exp;
+        CallExprNode* exp;
 
-        CallStatement(const std::shared_ptr<CallExprNode>&);
+        CallStatement(CallExprNode*);
 
     };
 
     struct AssignStatement : public Statement {
 
-        std::shared_ptr<AssignExprNode> exp;
+        AssignExprNode* exp;
 
-        AssignStatement(const std::shared_ptr<AssignExprNode>&);
+        AssignStatement(AssignExprNode*);
 
     };
 
     struct DefineStatement : public Statement {
 
         uint16_t storage;
-        std::shared_ptr<Identifier> name;
-        std::shared_ptr<Node> type;
-        std::shared_ptr<Node> def;
+        Identifier* name;
+        Node* type;
+        Node* def;
+        Node* align;
 
-        DefineStatement(uint16_t, const std::shared_ptr<Identifier>&, const std::shared_ptr<Node>&, const std::shared_ptr<Node>&);
+        DefineStatement(uint16_t, Identifier*, Node*, Node*, Node* = nullptr);
 
     };
 
     struct BlockNode : public Statement {
 
-        std::shared_ptr<BlockNode> parent;
-        std::vector<std::shared_ptr<Statement> > body;
-        std::map<std::string, std::shared_ptr<Identifier> > symbols;
+        BlockNode* parent;
+        std::vector<Statement*> body;
+        std::unordered_map<uint32_t, Identifier*> symbols;
 
-        BlockNode(uint16_t, const std::shared_ptr<BlockNode>& = nullptr);
+        BlockNode(uint16_t, BlockNode* = nullptr);
 
     };
 
     struct CondBlockNode : public BlockNode {
 
-        std::shared_ptr<Node> condition;
+        Node* condition;
 
-        CondBlockNode(const std::shared_ptr<BlockNode>&);
+        CondBlockNode(BlockNode*);
 
     };
 
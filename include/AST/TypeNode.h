@@ -35,41 +35,42 @@ namespace dmp {
 
     struct PointerTypeNode : public TypeNode {
 
-        std::shared_ptr<Node> points_to;
+        Node* points_to;
 
-        PointerTypeNode(const std::shared_ptr<Node>&);
+        PointerTypeNode(Node*);
     };
 
     struct ArrayTypeNode : public TypeNode {
 
-        std::shared_ptr<Node> nelements;
-        std::shared_ptr<Node> array_of;
+        Node* nelements;
+        Node* array_of;
 
-        ArrayTypeNode(const std::shared_ptr<Node>&, const std::shared_ptr<Node>&);
+        ArrayTypeNode(Node*, Node*);
     };
 
     struct StructTypeNode : public TypeNode {
 
-        std::shared_ptr<NameNodeSet> members;
+        NameNodeSet* members;
+        Node* align;
 
-        StructTypeNode(const std::shared_ptr<NameNodeSet>&, bool);
+        StructTypeNode(NameNodeSet*, bool, Node* = nullptr);
 
         bool isPacked() const;
     };
 
     struct UnionTypeNode : public TypeNode {
 
-        std::shared_ptr<NameNodeSet> members;
+        NameNodeSet* members;
 
-        UnionTypeNode(const std::shared_ptr<NameNodeSet>&);
+        UnionTypeNode(NameNodeSet*);
     };
 
     struct FunctionTypeNode : public TypeNode {
 
-        std::shared_ptr<NameNodeSet> args;
-        std::shared_ptr<Node> ret;
+        NameNodeSet* args;
+        Node* ret;
 
-        FunctionTypeNode(const std::shared_ptr<NameNodeSet>&, const std::shared_ptr<Node>&);
+        FunctionTypeNode(NameNodeSet*, Node*);
     };
 
 }
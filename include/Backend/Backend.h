@@ -7,15 +7,51 @@
 
 namespace dmp {
 
-    struct Backend : public Pass<void> {
+    enum OptLevel_ID {
+
+        OPT_LEVEL_O0,
+        OPT_LEVEL_O1,
+        OPT_LEVEL_O2,
+        OPT_LEVEL_O3,
+        OPT_LEVEL_OS,
+        OPT_LEVEL_OZ
+
+    };
+
+    enum Output_ID {
+
+        OUTPUT_OBJECT,
+        OUTPUT_ASSEMBLY,
+        OUTPUT_LLVM_IR,
+        OUTPUT_BITCODE
+
+    };
+
+    struct HostTarget {
+
+        std::string triple;
+        std::string cpu;
+        const llvm::Target* target;
+        std::string error_msg;
+
+        static const HostTarget& get();
+        static const llvm::Target* lookup(const std::string&, std::string&);
+    };
+
+    struct Backend : public Pass<std::shared_ptr<void> > {
 
         llvm::TargetMachine* machine;
         std::string srcfile;
         std::string outfile;
+        uint16_t optlevel;
+        uint16_t outputkind;
 
-        Backend(const std::string&, const std::string&);
+        Backend(const std::string&, const std::string&, uint16_t = OPT_LEVEL_O0, uint16_t = OUTPUT_OBJECT, const std::string& = "");
 
         virtual bool run() override;
+
+        bool optimize();
+        bool emit(llvm::raw_pwrite_stream&);
     };
 
 }
@@ -0,0 +1,47 @@
+#ifndef COMPILATIONCONTEXT_H
+#define COMPILATIONCONTEXT_H
+
+#include <memory>
+#include <string>
+#include <Common/Globals.h>
+
+namespace dmp {
+
+    struct Interner;
+    struct TypeContext;
+    struct StringPool;
+
+    /*
+
+    State of one compilation
+
+    The context owns everything that lives as long as the module being compiled: the LLVM context, module and IR
+    builder, the interner of names, the type uniquing table and the string literal pool. The compiler code reaches
+    these through TheContext, TheModule, TheBuilder, TheInterner, TheTypeContext and TheStringPool, which are
+    thread-local. Creating a context makes it the current one on the calling thread, and destroying it clears them.
+
+    Several compilations can therefore run in parallel in one process, provided each runs on its own thread (and
+    everything built during a compilation, including the pooled IR values, is dropped on that thread). A thread
+    can only have one context at a time.
+
+    */
+
+    struct CompilationContext {
+
+        std::unique_ptr<llvm::LLVMContext> context;
+        std::unique_ptr<llvm::Module> module;
+        std::unique_ptr<llvm::IRBuilder<> > builder;
+        std::unique_ptr<Interner> interner;
+        std::unique_ptr<TypeContext> types;
+        std::unique_ptr<StringPool> strings;
+
+        CompilationContext(const std::string&);
+        CompilationContext(const CompilationContext&) = delete;
+        CompilationContext& operator=(const CompilationContext&) = delete;
+        ~CompilationContext();
+
+    };
+
+}
+
+#endif
@@ -9,9 +9,13 @@
 
 namespace dmp {
 
-    extern std::unique_ptr<llvm::LLVMContext> TheContext;
-    extern std::unique_ptr<llvm::Module> TheModule;
-    extern std::unique_ptr<llvm::IRBuilder<> > TheBuilder;
+    /*
+    LLVM objects of the compilation running on this thread. They are owned by a CompilationContext, which sets
+    these pointers when it is created (see Common/CompilationContext.h)
+    */
+    extern thread_local llvm::LLVMContext* TheContext;
+    extern thread_local llvm::Module* TheModule;
+    extern thread_local llvm::IRBuilder<>* TheBuilder;
 
 }
 
@@ -0,0 +1,90 @@
+#ifndef INTERNER_H
+#define INTERNER_H
+
+#include <deque>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <string_view>
+#include <unordered_map>
+
+namespace dmp {
+
+    /*
+
+    String interner
+
+    Every distinct name is stored once and assigned a dense integer ID, in order of first appearance.
+    ID 0 is reserved for the empty name (e.g. an unnamed struct member).
+    The symbol tables of the compiler (AST, GST, LST) are keyed by these IDs rather than by strings.
+
+    */
+
+    struct Interner {
+
+        std::deque<std::string> strings;
+        std::unordered_map<std::string_view, uint32_t> ids;
+
+        Interner();
+
+        uint32_t intern(std::string_view);
+        const std::string& str(uint32_t) const;
+        std::size_t size() const;
+        void sort(std::vector<uint32_t>&) const;
+
+    };
+
+    extern thread_local Interner* TheInterner;
+
+    /*
+
+    Table indexed by symbol ID
+
+    Entries are stored in a flat vector that grows to the largest ID inserted so far.
+    As with std::map, operator[] creates the entry if it does not exist. An entry may exist and hold
+    an empty value (this is used to mark symbols that are in the process of being constructed).
+
+    */
+
+    template<typename T>
+    struct SymbolMap {
+
+        std::vector<T> values;
+        std::vector<bool> defined;
+
+        inline bool contains(uint32_t id) const {
+            return id < defined.size() && defined[id];
+        }
+
+        inline T& operator[](uint32_t id) {
+            if (id >= values.size()) {
+                values.resize(id+1);
+                defined.resize(id+1, false);
+            }
+            defined[id] = true;
+            return values[id];
+        }
+
+        inline void erase(uint32_t id) {
+            if (contains(id)) {
+                defined[id] = false;
+                values[id] = T();
+            }
+        }
+
+        std::vector<uint32_t> keys() const {
+            std::vector<uint32_t> ids;
+            for (std::size_t i = 0; i < defined.size(); i++) {
+                if (defined[i]) {
+                    ids.push_back(i);
+                }
+            }
+            return ids;
+        }
+
+    };
+
+}
+
+#endif
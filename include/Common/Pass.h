@@ -16,7 +16,7 @@ namespace dmp {
         InputManager* const input;
         AST* const ast;
         GST* const gst;
-        std::shared_ptr<T> result;
+        T result;
         std::vector<Error> errors;
 
         Pass(InputManager*, AST*, GST*);
@@ -29,9 +29,9 @@ namespace dmp {
 
         bool error();
         bool error(const std::string&);
+        bool error(const Location&, const std::string&);
         bool error(const Node&, const std::string&);
         bool error(const Node*, const std::string&);
-        bool error(const std::shared_ptr<Node>&, const std::string&);
         bool hasErrors() const;
         std::string errorPrintout();
 
@@ -0,0 +1,82 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <memory>
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+namespace dmp {
+
+    /*
+
+    Free-list allocator for small objects
+
+    Blocks are carved out of large chunks and rounded up to a multiple of 16 bytes. Freed blocks are kept on a
+    free list per size class and handed out again, so objects that are created and dropped all the time (e.g.
+    the Values produced by the IR builders) do not go through malloc. Larger requests fall back to operator new.
+    Each thread has its own pool; objects must not outlive the thread that created them.
+
+    */
+
+    struct Pool {
+
+        static constexpr std::size_t chunk_size = 64 * 1024;
+        static constexpr std::size_t granularity = 16;
+        static constexpr std::size_t nclasses = 16;
+
+        std::vector<std::unique_ptr<char[]> > chunks;
+        void* free_lists[nclasses];
+        char* next;
+        char* end;
+
+        Pool();
+        Pool(const Pool&) = delete;
+        Pool& operator=(const Pool&) = delete;
+
+        void* allocate(std::size_t);
+        void deallocate(void*, std::size_t);
+
+        static Pool& local();
+
+    };
+
+    template<typename T>
+    struct PoolAllocator {
+
+        using value_type = T;
+
+        PoolAllocator() = default;
+
+        template<typename U>
+        PoolAllocator(const PoolAllocator<U>&) {
+        }
+
+        T* allocate(std::size_t n) {
+            return static_cast<T*>(Pool::local().allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, std::size_t n) {
+            Pool::local().deallocate(p, n * sizeof(T));
+        }
+
+        template<typename U>
+        bool operator==(const PoolAllocator<U>&) const {
+            return true;
+        }
+
+        template<typename U>
+        bool operator!=(const PoolAllocator<U>&) const {
+            return false;
+        }
+
+    };
+
+    template<typename T, typename... Args>
+    std::shared_ptr<T> makePooled(Args&&... args) {
+        return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+    }
+
+}
+
+#endif
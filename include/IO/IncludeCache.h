@@ -0,0 +1,43 @@
+#ifndef INCLUDECACHE_H
+#define INCLUDECACHE_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+namespace dmp {
+
+    /*
+
+    Cache of precompiled include files
+
+    The blob of an include file (see IncludeUnit) is stored under a key made of the hash of the contents of the file
+    and of the compiler version (the AST format version, and the identity of the compiler executable), so that a
+    changed file or a rebuilt compiler simply misses. Blobs can be kept on disk, in a cache directory shared by all
+    compilations, where they are memory mapped when read, and in memory, where they are shared by all compilations of
+    the process (e.g. the jobs of a compile server). The in-memory store only keeps the blob of the latest contents of
+    each file (by path), so it does not grow as files are edited. Files are written under a temporary name and renamed
+    into place, so that concurrent compilations never see a partial blob. Every blob carries a header that is checked
+    on load; a blob that does not match is treated as a miss.
+
+    */
+
+    struct IncludeCache {
+
+        std::string directory;
+        bool inmemory;
+
+        IncludeCache(const std::string&, bool);
+
+        std::shared_ptr<llvm::MemoryBuffer> load(const std::string&, llvm::StringRef) const;
+        void store(const std::string&, llvm::StringRef, const std::string&) const;
+
+        static std::string_view contents(const llvm::MemoryBuffer&);
+
+    };
+
+}
+
+#endif
@@ -2,7 +2,8 @@
 #define INPUTFILE_H
 
 #include <string>
-#include <fstream>
+#include <memory>
+#include <llvm/Support/MemoryBuffer.h>
 #include <IO/InputManager.h>
 #include <Lexer/Lexer.h>
 
@@ -12,7 +13,7 @@ namespace dmp {
 
         const InputManager* manager;
         uint16_t index;
-        std::ifstream file;
+        std::unique_ptr<llvm::MemoryBuffer> buffer;
         Lexer* scanner;
 
         InputFile(const InputManager*, uint16_t);
@@ -11,6 +11,7 @@ namespace dmp {
 
     struct InputManager {
 
+        std::string directory;
         std::vector<std::string> filenames;
         std::vector<InputFile*> open;
         std::vector<InputFile*> closed;
@@ -23,6 +24,7 @@ namespace dmp {
         bool isActive(const std::string&) const;
         bool isValid() const;
         std::string getFileName(uint16_t) const;
+        std::string getFilePath(uint16_t) const;
 
         bool set(const std::string&);
         bool reset();
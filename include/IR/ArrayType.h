@@ -17,7 +17,6 @@ namespace dmp {
         ArrayType(const std::string&);
         ArrayType(const std::shared_ptr<Type>&, std::size_t);
 
-        virtual bool operator==(const Type&) const override;
         virtual bool construct(const std::shared_ptr<Type>&) override;
         virtual std::shared_ptr<Type> clone() const override;
 
@@ -39,7 +39,7 @@ namespace dmp {
         static std::shared_ptr<Value> logAnd(const std::shared_ptr<Value>&, const std::shared_ptr<Value>&);
         static std::shared_ptr<Value> logOr(const std::shared_ptr<Value>&, const std::shared_ptr<Value>&);
         static std::shared_ptr<Value> element(const std::shared_ptr<Variable>&, const std::shared_ptr<Value>&);
-        static std::shared_ptr<Value> member(const std::shared_ptr<Variable>&, const std::string&);
+        static std::shared_ptr<Value> member(const std::shared_ptr<Variable>&, uint32_t);
         static std::shared_ptr<Value> assign(const std::shared_ptr<Variable>&, const std::shared_ptr<Value>&);
         static uint16_t checkValidDivision(const std::shared_ptr<Value>&, const std::shared_ptr<Value>&);
 
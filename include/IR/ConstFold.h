@@ -0,0 +1,33 @@
+#ifndef CONSTFOLD_H
+#define CONSTFOLD_H
+
+#include <memory>
+#include <IR/Value.h>
+#include <IR/Literal.h>
+
+namespace dmp {
+
+    /*
+
+    Constant evaluation of operations on literals
+
+    When the operands of an arithmetic, bitwise, comparison or logical operation are all literals (int, real, bool
+    or char) the operation is evaluated in the compiler and the result is itself a literal. Integers wrap around
+    on overflow, exactly as the corresponding LLVM instructions do. A null value is returned when the operation
+    cannot be folded (e.g. the operands are not literals, or a shift is out of range) -- the caller then emits
+    the instruction as usual.
+
+    The operation IDs are the UNARYOP_* and BINARYOP_* IDs of the AST.
+
+    */
+
+    struct ConstFold {
+
+        static std::shared_ptr<Value> unary(uint16_t, const std::shared_ptr<Value>&);
+        static std::shared_ptr<Value> binary(uint16_t, const std::shared_ptr<Value>&, const std::shared_ptr<Value>&);
+
+    };
+
+}
+
+#endif
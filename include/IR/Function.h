@@ -27,11 +27,13 @@ namespace dmp {
         virtual void declare() override;
         virtual void init() override;
 
+        void enscope();
         void descope();
         void freeze();
         bool resume();
         bool checkTerminations();
         void simplify();
+        void promote();
     };
 
 }
@@ -16,7 +16,6 @@ namespace dmp {
 
         FunctionType(const std::vector<NameType>&, const std::shared_ptr<Type>&);
 
-        virtual bool operator==(const Type&) const override;
         virtual bool construct(const std::shared_ptr<Type>&) override;
         virtual std::shared_ptr<Type> clone() const override;
     };
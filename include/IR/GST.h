@@ -1,10 +1,9 @@
 #ifndef GST_H
 #define GST_H
 
-#include <map>
-#include <string>
 #include <memory>
 
+#include <Common/Interner.h>
 #include <IR/Type.h>
 #include <IR/Value.h>
 #include <IR/Variable.h>
@@ -13,10 +12,10 @@
 namespace dmp {
 
     struct GST {
-        std::map<std::string, std::shared_ptr<Type> > types;
-        std::map<std::string, std::shared_ptr<Value> > constants;
-        std::map<std::string, std::shared_ptr<Variable> > variables;
-        std::map<std::string, std::shared_ptr<Function> > functions;
+        SymbolMap<std::shared_ptr<Type> > types;
+        SymbolMap<std::shared_ptr<Value> > constants;
+        SymbolMap<std::shared_ptr<Variable> > variables;
+        SymbolMap<std::shared_ptr<Function> > functions;
     };
 
 }
@@ -2,27 +2,49 @@
 #define LST_H
 
 #include <memory>
-#include <map>
-#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
 #include <IR/Variable.h>
 #include <IR/Function.h>
 
 namespace dmp {
 
+    /*
+
+    Local symbol table of a function
+
+    All the scopes of a function share one hash table that maps a symbol ID to the stack of its live bindings,
+    innermost binding on top. Every binding is also recorded in an undo log, and each scope remembers where
+    the log stood when the scope was entered. Leaving a scope pops the bindings made since then.
+    A lookup is a single hash probe irrespective of the nesting depth.
+
+    */
+
     struct LST {
 
-        std::shared_ptr<LST> prev;
-        std::map<std::string, std::shared_ptr<Variable> > variables;
-        std::map<std::string, std::shared_ptr<Function> > functions;
+        struct Binding {
+            std::shared_ptr<Instance> inst;
+            std::size_t scope;
+        };
+
+        std::unordered_map<uint32_t, std::vector<Binding> > bindings;
+        std::vector<uint32_t> undo;
+        std::vector<std::size_t> scopes;
 
         LST();
-        LST(const Function&);
 
-        bool isDefined(const std::string&);
-        bool isDefinedInThisScope(const std::string&);
-        std::shared_ptr<Variable> getVariable(const std::string&);
-        std::shared_ptr<Function> getFunction(const std::string&);
-        std::shared_ptr<Instance> getInstance(const std::string&);
+        void enscope();
+        void descope();
+        std::size_t depth() const;
+
+        void bind(uint32_t, const std::shared_ptr<Instance>&);
+
+        bool isDefined(uint32_t) const;
+        bool isDefinedInThisScope(uint32_t) const;
+        std::shared_ptr<Variable> getVariable(uint32_t) const;
+        std::shared_ptr<Function> getFunction(uint32_t) const;
+        std::shared_ptr<Instance> getInstance(uint32_t) const;
 
     };
 
@@ -5,8 +5,20 @@
 
 namespace dmp {
 
+    /*
+
+    Block memory operations on variables
+
+    The memset/memcpy intrinsics are given the alignment known for the pointers involved, so that the backend can
+    use wide moves. Aggregates of up to inline_size bytes are not copied/cleared through the intrinsics at all, but
+    with a handful of integer loads and stores (at most 8 bytes wide).
+
+    */
+
     struct MemoryOp {
 
+        static constexpr std::size_t inline_size = 16;
+
         static bool memset(Variable*, uint8_t);
         static bool memset(const std::shared_ptr<Variable>&, uint8_t);
         static bool memcpy(const std::shared_ptr<Variable>&, const std::shared_ptr<Variable>&);
@@ -9,14 +9,16 @@ namespace dmp {
     struct PointerType : public Type {
 
         std::shared_ptr<Type> points_to;
+        std::shared_ptr<Type> direct;
 
         PointerType(const std::string&);
         PointerType(const std::shared_ptr<Type>&);
 
-        virtual bool operator==(const Type&) const override;
         virtual bool construct(const std::shared_ptr<Type>&) override;
         virtual std::shared_ptr<Type> clone() const override;
 
+        static std::shared_ptr<Type> directType(const std::shared_ptr<Type>&);
+
     };
 
 }
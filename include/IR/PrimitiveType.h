@@ -9,7 +9,6 @@ namespace dmp {
 
         PrimitiveType(int);
 
-        virtual bool operator==(const Type&) const override;
         virtual bool construct(const std::shared_ptr<Type>&) override;
         virtual std::shared_ptr<Type> clone() const override;
 
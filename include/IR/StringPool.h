@@ -0,0 +1,33 @@
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <llvm/IR/GlobalVariable.h>
+
+namespace dmp {
+
+    /*
+
+    Pool of the string literals of a module
+
+    Each distinct string is emitted once, as a private unnamed_addr constant (so that the backend can place it in a
+    mergeable .rodata.str section and fold it with identical strings from other objects). Every occurrence of the
+    string in the source refers to the same global.
+
+    */
+
+    struct StringPool {
+
+        std::unordered_map<std::string, llvm::GlobalVariable*> globals;
+
+        llvm::GlobalVariable* get(const std::string&);
+
+    };
+
+    extern thread_local StringPool* TheStringPool;
+
+}
+
+#endif
@@ -14,11 +14,11 @@ namespace dmp {
 
         public:
         std::vector<NameType> members;
+        std::size_t explicit_align;
 
         StructType(const std::string&, bool);
-        StructType(const std::vector<NameType>&, bool);
+        StructType(const std::vector<NameType>&, bool, std::size_t = 0);
 
-        virtual bool operator==(const Type&) const override;
         virtual bool construct(const std::shared_ptr<Type>&) override;
         virtual std::shared_ptr<Type> clone() const override;
 
@@ -5,26 +5,33 @@
 #include <string>
 #include <llvm/IR/Type.h>
 #include <Common/TypeBase.h>
+#include <IR/TypeContext.h>
 #include <IR/Entity.h>
 
 namespace dmp {
 
     struct Type : public Entity, public TypeBase {
 
-        static std::vector<std::pair<const Type*, const Type*> > being_compared;
-
         std::string name;
         llvm::Type* llvm_type;
         bool complete;
+        bool recursive;
+        uint32_t canon;
 
         Type(uint16_t);
         Type(uint16_t, const std::string&);
 
         virtual ~Type() = default;
 
-        virtual bool operator==(const Type&) const = 0;
-        virtual bool operator!=(const Type&) const;
-        
+        inline bool operator==(const Type& t) const {
+            return canon == t.canon;
+        }
+
+        inline bool operator!=(const Type& t) const {
+            return canon != t.canon;
+        }
+
+
         virtual bool construct(const std::shared_ptr<Type>&) = 0;
         virtual std::shared_ptr<Type> clone() const = 0;
 
@@ -0,0 +1,60 @@
+#ifndef TYPECONTEXT_H
+#define TYPECONTEXT_H
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+namespace dmp {
+
+    struct Type;
+
+    /*
+
+    Uniquing table for the structure of types
+
+    Every type is given a canonical ID when it is constructed. Two types have the same ID if and only if they
+    have the same structure, so type equality is a single integer comparison.
+    The structure of a type is keyed by its kind and the canonical IDs of its components (plus element counts,
+    member names and attributes where relevant).
+
+    A named type gets a fresh ID when it is created. When its body is constructed, it takes on the ID of the body,
+    unless the type was used as a component while it was still incomplete (i.e. the type is recursive). Recursive
+    types therefore keep their own identity.
+
+    The context also owns one shared instance of each primitive type (including void and unknown), and of the
+    pointer type to any given type object. These are handed out instead of constructing a new type every time
+    the IR builders need, say, a bool or a uint64.
+
+    */
+
+    struct TypeContext {
+
+        struct KeyHash {
+            std::size_t operator()(const std::vector<uint64_t>&) const;
+        };
+
+        std::unordered_map<std::vector<uint64_t>, uint32_t, KeyHash> ids;
+        uint32_t next;
+
+        std::vector<std::shared_ptr<Type> > primitives;
+        std::unordered_map<const Type*, std::shared_ptr<Type> > pointers;
+
+        TypeContext();
+
+        uint32_t unique(const std::vector<uint64_t>&);
+        uint32_t fresh();
+
+        const std::shared_ptr<Type>& primitive(uint16_t);
+        const std::shared_ptr<Type>& pointer(const std::shared_ptr<Type>&);
+
+        static uint64_t component(const std::shared_ptr<Type>&);
+
+    };
+
+    extern thread_local TypeContext* TheTypeContext;
+
+}
+
+#endif
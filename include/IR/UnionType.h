@@ -17,7 +17,6 @@ namespace dmp {
         UnionType(const std::string&);
         UnionType(const std::vector<NameType>&);
 
-        virtual bool operator==(const Type&) const override;
         virtual bool construct(const std::shared_ptr<Type>&) override;
         virtual std::shared_ptr<Type> clone() const override;
 
@@ -4,6 +4,7 @@
 #include <map>
 #include <llvm/IR/Value.h>
 #include <llvm/IR/Constants.h>
+#include <Common/Pool.h>
 #include <IR/Entity.h>
 #include <IR/Type.h>
 
@@ -8,6 +8,8 @@ namespace dmp {
 
     struct Variable : public Instance {
 
+        std::size_t explicit_align;
+
         Variable(int, const std::string&, const std::shared_ptr<Type>&);
 
         virtual llvm::Value* val() const override;
@@ -18,6 +20,9 @@ namespace dmp {
         void initGlobal(const std::shared_ptr<Value>&);
         void initExternal();
         bool align();
+        std::size_t alignment() const;
+
+        static llvm::Constant* conformConst(llvm::Constant*, llvm::Type*);
 
         inline bool isGlobal() {
             return (storage == STORAGE_EXTERNAL || storage == STORAGE_INTERNAL);
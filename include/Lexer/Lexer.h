@@ -1,9 +1,10 @@
 #ifndef LEXER_H
 #define LEXER_H
 
-#include <map>
+#include <array>
+#include <cstdint>
 #include <string>
-#include <fstream>
+#include <string_view>
 #include <IO/Coordinate.h>
 
 namespace dmp {
@@ -35,43 +36,6 @@ namespace dmp {
 
     };
 
-    struct Lexer {
-
-        static const std::string bin;
-        static const std::string oct;
-        static const std::string dec;
-        static const std::string hex;
-        static const std::string wspace;
-        static const std::string letter;
-        static const std::string escchar;
-        static std::map<int, std::string> symbols;
-        static std::map<int, std::string> keywords;
-
-        std::ifstream& file;
-        bool input_error;
-        int next_char;
-        int state;
-	Coordinate start;
-	Coordinate end;
-	Coordinate last;
-	Coordinate next;
-        std::string token_string;
-        std::string token_buffer;
-
-        int (*state_processors[LEXER_STATE_TOTAL_NUM_STATES])(bool exact, const std::string& token_buffer, int& state);
-
-        Lexer(std::ifstream&);
-
-        void populate_state_processors();
-        void read();
-        void append();
-        void unappend();
-        int  rule();
-        int  lex();
-        int  match(bool);
-
-    };
-
     enum Rule_ID {
 
         RULE_ERROR,
@@ -111,6 +75,7 @@ namespace dmp {
         RULE_UNION,
         RULE_FUNCTION,
         RULE_PACKED,
+        RULE_ALIGN,
         RULE_EXTERN,
 
         RULE_IF,
@@ -179,6 +144,166 @@ namespace dmp {
 
     };
 
+    enum Char_Class_ID {
+
+        CHAR_BIN        = 1 << 0,
+        CHAR_OCT        = 1 << 1,
+        CHAR_DEC        = 1 << 2,
+        CHAR_HEX        = 1 << 3,
+        CHAR_WSPACE     = 1 << 4,
+        CHAR_LETTER     = 1 << 5,
+        CHAR_UNDERSCORE = 1 << 6,
+        CHAR_ESCCHAR    = 1 << 7,
+        CHAR_STRING     = 1 << 8,
+        CHAR_LAYOUT     = 1 << 9
+
+    };
+
+    struct LexerPattern {
+
+        int rule;
+        std::string_view text;
+
+    };
+
+    struct Lexer {
+
+        static constexpr std::string_view bin     = "01";
+        static constexpr std::string_view oct     = "01234567";
+        static constexpr std::string_view dec     = "0123456789";
+        static constexpr std::string_view hex     = "0123456789abcdefABCDEF";
+        static constexpr std::string_view wspace  = " \t\n\r\v\f";
+        static constexpr std::string_view letter  = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+        static constexpr std::string_view escchar = "\a\b\t\n\r\v\f\'\"\\";
+        static constexpr std::string_view layout  = "\n\r\t\v";
+        static const std::array<uint16_t, 256> charclass;
+
+        static constexpr LexerPattern symbols[] = {
+            { RULE_CURLY_OPEN,       "{"        },
+            { RULE_CURLY_CLOSE,      "}"        },
+            { RULE_SQUARE_OPEN,      "["        },
+            { RULE_SQUARE_CLOSE,     "]"        },
+            { RULE_ROUND_OPEN,       "("        },
+            { RULE_ROUND_CLOSE,      ")"        },
+            { RULE_COMMA,            ","        },
+            { RULE_SEMICOLON,        ";"        },
+
+            { RULE_DECLARE,          ":"        },
+            { RULE_REPRESENTS,       "::"       },
+            { RULE_DEFINE,           ":="       },
+            { RULE_RETURNS,          "->"       },
+            { RULE_CAST,             "=>"       },
+
+            { RULE_PLUS,             "+"        },
+            { RULE_MINUS,            "-"        },
+            { RULE_MULTIPLY,         "*"        },
+            { RULE_DIVIDE,           "/"        },
+            { RULE_REMAINDER,        "%"        },
+
+            { RULE_ADDRESS,          "@"        },
+            { RULE_SIZE,             "#"        },
+            { RULE_DEREF,            "$"        },
+            { RULE_DOT,              "."        },
+
+            { RULE_COMPLEMENT,       "~"        },
+            { RULE_BIT_AND,          "&"        },
+            { RULE_BIT_OR,           "|"        },
+            { RULE_BIT_XOR,          "^"        },
+            { RULE_BIT_RIGHT,        ">>"       },
+            { RULE_BIT_LEFT,         "<<"       },
+
+            { RULE_GREATER,          ">"        },
+            { RULE_LESSER,           "<"        },
+            { RULE_GEQ,              ">="       },
+            { RULE_LEQ,              "<="       },
+            { RULE_EQUAL,            "=="       },
+            { RULE_NOT_EQUAL,        "!="       },
+            { RULE_NOT,              "!"        },
+            { RULE_LOG_AND,          "&&"       },
+            { RULE_LOG_OR,           "!!"       },
+
+            { RULE_ASSIGN,           "="        },
+            { RULE_ADD_ASSIGN,       "+="       },
+            { RULE_SUB_ASSIGN,       "-="       },
+            { RULE_MUL_ASSIGN,       "*="       },
+            { RULE_DIV_ASSIGN,       "/="       },
+            { RULE_REM_ASSIGN,       "%="       },
+            { RULE_AND_ASSIGN,       "&="       },
+            { RULE_OR_ASSIGN,        "|="       },
+            { RULE_XOR_ASSIGN,       "^="       },
+            { RULE_BIT_RIGHT_ASSIGN, ">>="      },
+            { RULE_BIT_LEFT_ASSIGN,  "<<="      },
+
+            { RULE_GENERIC_POINTER,  "@?"       }
+        };
+
+        static constexpr LexerPattern keywords[] = {
+            { RULE_INCLUDE,          "include"  },
+
+            { RULE_MAIN,             "main"     },
+
+            { RULE_TRUE,             "true"     },
+            { RULE_FALSE,            "false"    },
+
+            { RULE_BOOL,             "bool"     },
+            { RULE_UINT8,            "uint8"    },
+            { RULE_UINT16,           "uint16"   },
+            { RULE_UINT32,           "uint32"   },
+            { RULE_UINT64,           "uint64"   },
+            { RULE_INT8,             "int8"     },
+            { RULE_INT16,            "int16"    },
+            { RULE_INT32,            "int32"    },
+            { RULE_INT64,            "int64"    },
+            { RULE_REAL32,           "real32"   },
+            { RULE_REAL64,           "real64"   },
+            { RULE_STRUCT,           "struct"   },
+            { RULE_UNION,            "union"    },
+            { RULE_FUNCTION,         "func"     },
+            { RULE_EXTERN,           "extern"   },
+            { RULE_PACKED,           "packed"   },
+            { RULE_ALIGN,            "align"    },
+
+            { RULE_IF,               "if"       },
+            { RULE_ELSE,             "else"     },
+            { RULE_LOOP,             "loop"     },
+            { RULE_WHILE,            "while"    },
+            { RULE_FOR,              "for"      },
+            { RULE_BREAK,            "break"    },
+            { RULE_CONTINUE,         "continue" },
+            { RULE_RETURN,           "return"   }
+        };
+
+        std::string_view source;
+        std::size_t position;
+        std::size_t token_begin;
+        int next_char;
+        int state;
+	Coordinate start;
+	Coordinate end;
+	Coordinate last;
+	Coordinate next;
+        std::string_view token_string;
+        std::string_view token_buffer;
+
+        int (*state_processors[LEXER_STATE_TOTAL_NUM_STATES])(bool exact, std::string_view token_buffer, int& state);
+
+        Lexer(std::string_view);
+
+        void populate_state_processors();
+        void read();
+        void advance(int);
+        void append();
+        void unappend();
+        void skip();
+        int  rule();
+        int  lex();
+        int  match(bool);
+
+        static inline bool in_class(char c, uint16_t cls) {
+            return (charclass[(unsigned char)c] & cls) != 0;
+        }
+
+    };
 }
 
 #endif
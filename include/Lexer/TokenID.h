@@ -40,6 +40,7 @@ namespace dmp {
         TOKEN_FUNCTION,
         TOKEN_EXTERN,
         TOKEN_PACKED,
+        TOKEN_ALIGN,
         
         TOKEN_RETURN,
         TOKEN_IF,
@@ -103,7 +104,9 @@ namespace dmp {
         TOKEN_OR_ASSIGN,
         TOKEN_XOR_ASSIGN,
         TOKEN_BIT_RIGHT_ASSIGN,
-        TOKEN_BIT_LEFT_ASSIGN
+        TOKEN_BIT_LEFT_ASSIGN,
+
+        TOKEN_NTOKENS
 
     };
 
@@ -0,0 +1,70 @@
+#ifndef TOKENSTREAM_H
+#define TOKENSTREAM_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <IO/Coordinate.h>
+#include <IO/Location.h>
+#include <AST/Token.h>
+
+namespace dmp {
+
+    /*
+
+    Tokens are stored as parallel arrays rather than as individually allocated Token objects.
+    The text of a token is a slice of the source buffer of its file, given by an offset and a length.
+    Coordinates are packed into 64-bit integers (line in the upper bits, column in the lower 16 bits).
+    A Token is only materialized on request through token().
+
+    Tokens are addressed by their absolute position in the stream. The arrays form a sliding window 
+    starting at position 'first' : tokens that have been consumed are dropped from the front of the window 
+    in bulk, once they make up more than half of it. mark() records the current end of the stream 
+    (e.g. before the tokens of an include file are scanned) and rewind() drops everything after the last mark. 
+    Consumed tokens are only dropped while a single mark is active (i.e. no include file is being parsed), 
+    so that an enclosing parse can still access its lookahead.
+
+    */
+
+    struct TokenStream {
+
+        std::vector<std::string_view> sources;
+        std::vector<std::size_t> marks;
+        std::size_t first;
+
+        std::vector<uint16_t> kinds;
+        std::vector<uint16_t> files;
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> lengths;
+        std::vector<uint64_t> starts;
+        std::vector<uint64_t> ends;
+
+        TokenStream();
+
+        std::size_t size() const;
+
+        void push_back(int, uint16_t, std::string_view, std::string_view, const Coordinate&, const Coordinate&);
+        void consume(std::size_t);
+        std::size_t mark();
+        void rewind();
+
+        int kind(std::size_t) const;
+        std::string_view text(std::size_t) const;
+        std::string str(std::size_t) const;
+        Location loc(std::size_t) const;
+        Token token(std::size_t) const;
+
+        static inline uint64_t pack(const Coordinate& c) {
+            return (uint64_t(c.line) << 16) | c.column;
+        }
+
+        static inline Coordinate unpack(uint64_t c) {
+            return Coordinate(uint32_t(c >> 16), uint16_t(c & 0xFFFF));
+        }
+
+    };
+
+}
+
+#endif
@@ -4,47 +4,103 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <unordered_map>
 
 #include <Common/Pass.h>
-#include <AST/Token.h>
+#include <Lexer/TokenStream.h>
 #include <AST/AST.h>
 #include <AST/Identifier.h>
 #include <AST/Statement.h>
+#include <AST/IncludeUnit.h>
+#include <IO/IncludeCache.h>
 
 namespace dmp {
 
-    struct Parser : public Pass<Node> {
+    /*
 
-        std::vector<std::shared_ptr<Token> > tokens;
+    Packrat memoization of the backtracking parser
+
+    Rules that do not depend on anything but the token position (types and expressions) can be memoized.
+    The outcome of such a rule at a given token position is recorded the first time it is parsed (number of 
+    tokens parsed, the resulting node and the errors it left behind) and replayed whenever the same rule is 
+    tried again at the same position by a different alternative. 
+    The table is cleared after each global unit, and after each include file. 
+
+    */
+
+    enum Memo_Rule_ID {
+
+        MEMO_TYPE,
+        MEMO_EXPR,
+        MEMO_UNARY,
+        MEMO_NRULES
+
+    };
+
+    struct ParseMemo {
+
+        bool status;
+        bool cleared;
+        std::size_t nParsed;
+        Node* result;
+        std::vector<Error> errors;
+
+    };
+
+    /*
+
+    When an include cache is given, every include file is first looked up in it. On a hit the recorded units of the
+    file are replayed into the AST (with the same redefinition checks as when they are parsed), and the files it
+    includes are included in turn. On a miss the file is parsed while its units are recorded, and the record is
+    stored in the cache if the file parses without errors. 'units' holds the records of the include files that are
+    being parsed, innermost last.
+
+    */
+
+    struct Parser : public Pass<Node*> {
+
+        TokenStream tokens;
         std::size_t nParsed;
+        std::size_t nSucceeded;
+        bool memoize;
+        std::unordered_map<std::size_t, ParseMemo> memo;
+        const IncludeCache* cache;
+        std::vector<IncludeUnit> units;
 
-        Parser(InputManager*, AST*);
+        Parser(InputManager*, AST*, bool = false, const IncludeCache* = nullptr);
    
         virtual void fail() override; 
         virtual bool run() override;
 
         bool success(std::size_t n);
 
-        std::shared_ptr<Token> scan();
+        void scan();
 
         bool isUnaryOp(std::size_t);
         bool isBinaryMathOp(std::size_t);
         bool isAssigner(std::size_t);
         bool isLiteral(std::size_t);
         bool isAvailable(std::size_t);
-        bool isAvailableLocally(std::size_t, const std::shared_ptr<BlockNode>&);
+        bool isAvailable(const std::string&, const Location&);
+        bool isAvailableLocally(std::size_t, BlockNode*);
 
         bool parseToken(std::size_t, int);
+        bool parseMemoized(int, std::size_t, bool (Parser::*)(std::size_t));
 
         bool parseProg(std::size_t);
         bool parseEmpty(std::size_t);
         bool parseInclude(std::size_t);
+        bool include(const std::string&, const Location&);
+        bool includeCached();
+        bool replay(const IncludeUnit&);
+        void record(uint16_t, Node*);
         bool parseRepresentation(std::size_t);
         bool parseDeclaration(std::size_t);
         bool parseDefinition(std::size_t);
         bool parseRefDef(std::size_t);
 
         bool parseType(std::size_t);
+        bool parseTypeNoMemo(std::size_t);
         bool parseDataType(std::size_t);
         bool parsePrimitiveType(std::size_t);
         bool parsePointerType(std::size_t);
@@ -54,26 +110,29 @@ namespace dmp {
         bool parseFuncType(std::size_t);
         bool parseMembers(std::size_t);
         bool parseArguments(std::size_t);
+        bool parseAlignment(std::size_t);
 
         bool parseInit(std::size_t);
         bool parseUntaggedInitSet(std::size_t);
         bool parseTaggedInitSet(std::size_t);
 
         bool parseExpr(std::size_t);
+        bool parseExprNoMemo(std::size_t);
         bool parseUnary(std::size_t);
+        bool parseUnaryNoMemo(std::size_t);
         bool parseUnaryNoRecast(std::size_t);
         bool parseLiteral(std::size_t);
         bool parsePreOpUnary(std::size_t);
         bool parsePostOpUnary(std::size_t);
-        bool parseBinaryOperationRHS(std::size_t, int, const std::shared_ptr<Node>&);
+        bool parseBinaryOperationRHS(std::size_t, int, Node*);
 
         bool parseFunc(std::size_t);
-        bool parseStatement(std::size_t, const std::shared_ptr<BlockNode>&);
-        bool parseBlock(std::size_t, const std::shared_ptr<BlockNode>&);
-        bool parseLocalVarDef(std::size_t, const std::shared_ptr<BlockNode>&);
-        bool parseLocalRefDef(std::size_t, const std::shared_ptr<BlockNode>&);
-        bool parseIf(std::size_t, const std::shared_ptr<BlockNode>&);
-        bool parseLoop(std::size_t, const std::shared_ptr<BlockNode>&);
+        bool parseStatement(std::size_t, BlockNode*);
+        bool parseBlock(std::size_t, BlockNode*);
+        bool parseLocalVarDef(std::size_t, BlockNode*);
+        bool parseLocalRefDef(std::size_t, BlockNode*);
+        bool parseIf(std::size_t, BlockNode*);
+        bool parseLoop(std::size_t, BlockNode*);
 
     };
 
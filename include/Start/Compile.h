@@ -2,10 +2,52 @@
 #define COMPILE_H
 
 #include <string>
+#include <vector>
+#include <iostream>
+#include <Backend/Backend.h>
 
 namespace dmp {
 
-    void compile(const std::string&, const std::string&);
+    struct CompileOptions {
+
+        uint16_t optlevel;
+        uint16_t outputkind;
+        bool memoize;
+        bool ssa;
+        std::string triple;
+        std::string directory;
+        std::string cachedir;
+        bool cachemem;
+
+        CompileOptions();
+    };
+
+    /*
+
+    A set of files to compile, as given on the command line
+
+    Either a single source and output file, or any number of sources compiled into an output directory
+    (with up to 'jobs' of them compiled in parallel). Relative paths are taken with respect to the working
+    directory in the options (the current directory of the process if it is empty).
+
+    */
+
+    struct CompileJob {
+
+        CompileOptions opts;
+        std::vector<std::string> srcfiles;
+        std::vector<std::string> outfiles;
+        std::string outdir;
+        std::size_t jobs;
+
+        CompileJob();
+
+        bool parse(const std::vector<std::string>&, std::ostream&);
+        bool run(std::ostream&) const;
+    };
+
+    bool compile(const std::string&, const std::string&, const CompileOptions& = CompileOptions(), std::ostream& = std::cerr);
+    bool compile(const std::vector<std::string>&, const std::vector<std::string>&, std::size_t, const CompileOptions& = CompileOptions(), std::ostream& = std::cerr);
         
 }
 
@@ -0,0 +1,33 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <string>
+#include <vector>
+
+namespace dmp {
+
+    /*
+
+    Compile server
+
+    'dimple --server socket [-j N]' listens on a Unix domain socket and compiles the jobs sent to it with
+    'dimple --connect socket [options] files ...'. The options and files are exactly those of a direct invocation,
+    and relative paths are taken with respect to the working directory of the client. The server keeps the
+    process-wide LLVM state (target registry, host detection), a target machine per worker thread and the include
+    files it has parsed (see IncludeCache) from one job to the next, so that a job only costs the compilation itself.
+    Up to N jobs are served in parallel (default 1). 'dimple --connect socket --shutdown' stops the server.
+
+    The client sends its working directory and then its arguments, each terminated by a NUL character, and closes
+    its end of the connection for writing. The server replies with '0' (success) or '1' (failure), followed by the
+    diagnostics of the job, and closes the connection. Only the user running the server can connect to it (the
+    socket file is private, and the credentials of the peer are checked). A client that has not sent its whole
+    request within a few seconds is dropped, so that it cannot hold up a worker.
+
+    */
+
+    int runServer(const std::vector<std::string>&);
+    int runClient(const std::vector<std::string>&);
+
+}
+
+#endif
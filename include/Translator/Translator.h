@@ -22,11 +22,18 @@
 
 namespace dmp {
 
-    struct Translator : public Pass<Entity> {
+    struct Translator : public Pass<std::shared_ptr<Entity> > {
+
+        /* Local arrays/structs of at least this size (in bytes) with constant initializers are built from a constant */
+        static constexpr std::size_t const_init_size = 64;
+
+        /* Largest alignment that can be given to a type or variable with 'align' */
+        static constexpr std::size_t max_align = 4096;
 
         std::shared_ptr<Function> currentFunction;
+        bool ssa;
 
-        Translator(InputManager*, AST*, GST*);
+        Translator(InputManager*, AST*, GST*, bool = false);
 
         virtual void fail() override; 
         virtual bool run() override;
@@ -34,51 +41,56 @@ namespace dmp {
         bool createRepresentations();
         bool createGlobals();
 
-        bool getType(const std::shared_ptr<Node>&, bool includeOpaquePtr = false);
-        bool getTypeRep(const std::shared_ptr<Identifier>&, bool includeOpaquePtr = false);
-        bool getPtrType(const std::shared_ptr<PointerTypeNode>&, bool includeOpaquePtr);
-        bool getArrayType(const std::shared_ptr<ArrayTypeNode>&, bool includeOpaquePtr);
-        bool getStructType(const std::shared_ptr<StructTypeNode>&, bool includeOpaquePtr);
-        bool getUnionType(const std::shared_ptr<UnionTypeNode>&, bool includeOpaquePtr);
-        bool getFunctionType(const std::shared_ptr<FunctionTypeNode>&, bool includeOpaquePtr);
-        bool checkDuplicateNames(const std::shared_ptr<NameNodeSet>&);
-
-        bool getValue(const std::shared_ptr<Node>&);
-        bool getConstRep(const std::shared_ptr<Identifier>&);
-        bool getGlobalInstance(const std::shared_ptr<Identifier>&);
-        bool getGlobalRef(const std::shared_ptr<Identifier>&);
-        bool literal(const std::shared_ptr<ExprNode>&);
-        bool unary(const std::shared_ptr<UnaryExprNode>&);
-        bool recast(const std::shared_ptr<BinaryExprNode>&);
-        bool member(const std::shared_ptr<BinaryExprNode>&);
-        bool element(const std::shared_ptr<BinaryExprNode>&);
-        bool binary(const std::shared_ptr<ExprNode>&);
-        bool assign(const std::shared_ptr<Variable>&, const std::shared_ptr<Node>&);
-
-        bool getGlobalVar(const std::shared_ptr<Identifier>&, uint16_t, const std::shared_ptr<Type>&);
-        bool initGlobal(const std::shared_ptr<Variable>&, const std::shared_ptr<Node>&);
-        bool initLocal(const std::shared_ptr<Variable>&, const std::shared_ptr<Node>&);
-        bool initLocalArray(const std::shared_ptr<Variable>&, const std::shared_ptr<Initializer>&);
-        bool initLocalStruct(const std::shared_ptr<Variable>&, const std::shared_ptr<Initializer>&);
-        bool initLocalUnion(const std::shared_ptr<Variable>&, const std::shared_ptr<Initializer>&);
-        bool initConst(const std::shared_ptr<Type>&, const std::shared_ptr<Node>&);
-        bool initSimpleConst(const std::shared_ptr<Type>&, const std::shared_ptr<Node>&);
-        bool initArrayConst(const std::shared_ptr<ArrayType>&, const std::shared_ptr<Initializer>&);
-        bool initStructConst(const std::shared_ptr<StructType>&, const std::shared_ptr<Initializer>&);
-        bool initUnionConst(const std::shared_ptr<UnionType>&, const std::shared_ptr<Initializer>&);
+        bool getType(Node*, bool includeOpaquePtr = false);
+        bool getTypeRep(Identifier*, bool includeOpaquePtr = false);
+        bool getPtrType(PointerTypeNode*, bool includeOpaquePtr);
+        bool getArrayType(ArrayTypeNode*, bool includeOpaquePtr);
+        bool getStructType(StructTypeNode*, bool includeOpaquePtr);
+        bool getUnionType(UnionTypeNode*, bool includeOpaquePtr);
+        bool getFunctionType(FunctionTypeNode*, bool includeOpaquePtr);
+        bool getAlignment(Node*, std::size_t&);
+        bool checkDuplicateNames(NameNodeSet*);
+
+        bool getValue(Node*);
+        bool getConstRep(Identifier*);
+        bool getGlobalInstance(Identifier*);
+        bool getGlobalRef(Identifier*);
+        bool literal(ExprNode*);
+        bool unary(UnaryExprNode*);
+        bool recast(BinaryExprNode*);
+        bool member(BinaryExprNode*);
+        bool element(BinaryExprNode*);
+        bool binary(ExprNode*);
+        bool assign(const std::shared_ptr<Variable>&, Node*);
+
+        bool getGlobalVar(Identifier*, uint16_t, const std::shared_ptr<Type>&);
+        bool initGlobal(const std::shared_ptr<Variable>&, Node*);
+        bool initLocal(const std::shared_ptr<Variable>&, Node*);
+        bool initLocalArray(const std::shared_ptr<Variable>&, Initializer*);
+        bool initLocalStruct(const std::shared_ptr<Variable>&, Initializer*);
+        bool initLocalUnion(const std::shared_ptr<Variable>&, Initializer*);
+        bool initLocalConst(const std::shared_ptr<Variable>&, Initializer*);
+        bool isConstInitializer(Node*);
+        bool initConst(const std::shared_ptr<Type>&, Node*);
+        bool initSimpleConst(const std::shared_ptr<Type>&, Node*);
+        bool initArrayConst(const std::shared_ptr<ArrayType>&, Initializer*);
+        bool initStructConst(const std::shared_ptr<StructType>&, Initializer*);
+        bool initUnionConst(const std::shared_ptr<UnionType>&, Initializer*);
+        bool getArrayConsts(const std::shared_ptr<ArrayType>&, Initializer*, std::map<std::size_t, std::shared_ptr<Value> >&);
+        bool getStructConsts(const std::shared_ptr<StructType>&, Initializer*, std::map<std::size_t, std::shared_ptr<Value> >&);
         bool getArrayTypeIndex(const std::shared_ptr<ArrayType>&, const InitElement&, std::size_t&);
         bool getStructTypeIndex(const std::shared_ptr<StructType>&, const InitElement&, std::size_t&);
         bool getUnionTypeIndex(const std::shared_ptr<UnionType>&, const InitElement&, std::size_t&);
 
-        bool getFunction(const std::shared_ptr<Identifier>&, uint16_t, const std::shared_ptr<Type>&);
-        bool defineFunction(const std::shared_ptr<DefineStatement>&);
-        bool defineLocalVar(const std::shared_ptr<DefineStatement>&);
-        bool defineLocalRef(const std::shared_ptr<DefineStatement>&);
-        bool defineBlock(const std::shared_ptr<BlockNode>&, std::shared_ptr<CodeBlock> = nullptr, std::shared_ptr<CodeBlock> = nullptr);
-        bool defineIfBlock(const std::shared_ptr<BlockNode>&, std::shared_ptr<CodeBlock>, std::shared_ptr<CodeBlock>);
-        bool defineLoopBlock(const std::shared_ptr<BlockNode>&);
-        bool call(const std::shared_ptr<CallExprNode>&, const std::shared_ptr<Variable>& = nullptr);
-        bool ret(const std::shared_ptr<ReturnStatement>&);
+        bool getFunction(Identifier*, uint16_t, const std::shared_ptr<Type>&);
+        bool defineFunction(DefineStatement*);
+        bool defineLocalVar(DefineStatement*);
+        bool defineLocalRef(DefineStatement*);
+        bool defineBlock(BlockNode*, std::shared_ptr<CodeBlock> = nullptr, std::shared_ptr<CodeBlock> = nullptr);
+        bool defineIfBlock(BlockNode*, std::shared_ptr<CodeBlock>, std::shared_ptr<CodeBlock>);
+        bool defineLoopBlock(BlockNode*);
+        bool call(CallExprNode*, const std::shared_ptr<Variable>& = nullptr);
+        bool ret(ReturnStatement*);
     };
 
 }
@@ -2,18 +2,18 @@
 
 namespace dmp {
 
-    std::shared_ptr<Node> AST::getNonSynonymRepNode(const std::shared_ptr<Identifier>& ident) {
+    Node* AST::getNonSynonymRepNode(Identifier* ident) {
 
-        if (representations.find(ident->name) == representations.end()) {
+        if (!representations.contains(ident->id)) {
             return ident;
         }
-        auto next_node = representations[ident->name]->node;
+        auto next_node = representations[ident->id]->node;
         while (next_node->kind == NODE_IDENTIFIER) {
-            const auto& nm = static_cast<Identifier*>(next_node.get())->name;
-            if (representations.find(nm) == representations.end()) {
+            auto id = static_cast<Identifier*>(next_node)->id;
+            if (!representations.contains(id)) {
                 break;
             }
-            next_node = representations[nm]->node;
+            next_node = representations[id]->node;
         }
         return next_node;
     }
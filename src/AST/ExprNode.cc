@@ -4,50 +4,71 @@
 
 namespace dmp {
 
-    std::map<int, uint16_t> ExprNode::unopsmap = {
-        {TOKEN_DEREF     , UNARYOP_DEREFERENCE},
-        {TOKEN_ADDRESS   , UNARYOP_ADDRESS    },
-        {TOKEN_SIZE      , UNARYOP_SIZE       },
-        {TOKEN_PLUS      , UNARYOP_PLUS       },
-        {TOKEN_MINUS     , UNARYOP_NEGATE     },
-        {TOKEN_NOT       , UNARYOP_NOT        },
-        {TOKEN_COMPLEMENT, UNARYOP_COMPLEMENT }
-    };
+    static constexpr void unary(std::array<OperatorInfo, TOKEN_NTOKENS - TOKEN_NONE>& table, int t, uint16_t op) {
+        table[t - TOKEN_NONE].kind |= OPKIND_UNARY;
+        table[t - TOKEN_NONE].unop = op;
+    }
 
-    std::map<int, uint16_t> ExprNode::binopsmap = {
-        {TOKEN_LOG_OR    , BINARYOP_LOGICAL_OR   },
-        {TOKEN_LOG_AND   , BINARYOP_LOGICAL_AND  },
-        {TOKEN_EQUAL     , BINARYOP_EQUAL        },
-        {TOKEN_NOT_EQUAL , BINARYOP_NOT_EQUAL    },
-        {TOKEN_GEQ       , BINARYOP_GREATER_EQUAL},
-        {TOKEN_LEQ       , BINARYOP_LESSER_EQUAL },
-        {TOKEN_GREATER   , BINARYOP_GREATER      },
-        {TOKEN_LESSER    , BINARYOP_LESSER       },
-        {TOKEN_BIT_OR    , BINARYOP_BIT_OR       },
-        {TOKEN_BIT_XOR   , BINARYOP_BIT_XOR      },
-        {TOKEN_BIT_AND   , BINARYOP_BIT_AND      },
-        {TOKEN_BIT_LEFT  , BINARYOP_SHIFT_LEFT   },
-        {TOKEN_BIT_RIGHT , BINARYOP_SHIFT_RIGHT  },
-        {TOKEN_PLUS      , BINARYOP_ADD          },
-        {TOKEN_MINUS     , BINARYOP_SUBTRACT     },
-        {TOKEN_MULTIPLY  , BINARYOP_MULTIPLY     },
-        {TOKEN_DIVIDE    , BINARYOP_DIVIDE       },
-        {TOKEN_REMAINDER , BINARYOP_REMAINDER    }
-    };
+    static constexpr void binary(std::array<OperatorInfo, TOKEN_NTOKENS - TOKEN_NONE>& table, int t, uint16_t op, int prec) {
+        table[t - TOKEN_NONE].kind |= OPKIND_BINARY;
+        table[t - TOKEN_NONE].binop = op;
+        table[t - TOKEN_NONE].assoc = ASSOC_LEFT;
+        table[t - TOKEN_NONE].prec = prec;
+    }
 
-    std::map<int, uint16_t> ExprNode::assopsmap = {
-        {TOKEN_ASSIGN          , ASSIGNOP_ASSIGN          },
-        {TOKEN_ADD_ASSIGN      , ASSIGNOP_ADD_ASSIGN      },
-        {TOKEN_SUB_ASSIGN      , ASSIGNOP_SUB_ASSIGN      },
-        {TOKEN_MUL_ASSIGN      , ASSIGNOP_MUL_ASSIGN      },
-        {TOKEN_DIV_ASSIGN      , ASSIGNOP_DIV_ASSIGN      },
-        {TOKEN_REM_ASSIGN      , ASSIGNOP_REM_ASSIGN      },
-        {TOKEN_AND_ASSIGN      , ASSIGNOP_AND_ASSIGN      },
-        {TOKEN_OR_ASSIGN       , ASSIGNOP_OR_ASSIGN       },
-        {TOKEN_XOR_ASSIGN      , ASSIGNOP_XOR_ASSIGN      },
-        {TOKEN_BIT_RIGHT_ASSIGN, ASSIGNOP_BIT_RIGHT_ASSIGN},
-        {TOKEN_BIT_LEFT_ASSIGN , ASSIGNOP_BIT_LEFT_ASSIGN }
-    };
+    static constexpr void assign(std::array<OperatorInfo, TOKEN_NTOKENS - TOKEN_NONE>& table, int t, uint16_t op) {
+        table[t - TOKEN_NONE].kind |= OPKIND_ASSIGN;
+        table[t - TOKEN_NONE].assop = op;
+        table[t - TOKEN_NONE].assoc = ASSOC_RIGHT;
+        table[t - TOKEN_NONE].prec = 10;
+    }
+
+    static constexpr std::array<OperatorInfo, TOKEN_NTOKENS - TOKEN_NONE> make_optable() {
+
+        std::array<OperatorInfo, TOKEN_NTOKENS - TOKEN_NONE> table{};
+
+        unary (table, TOKEN_ADDRESS   , UNARYOP_ADDRESS    );
+        unary (table, TOKEN_SIZE      , UNARYOP_SIZE       );
+        unary (table, TOKEN_PLUS      , UNARYOP_PLUS       );
+        unary (table, TOKEN_MINUS     , UNARYOP_NEGATE     );
+        unary (table, TOKEN_NOT       , UNARYOP_NOT        );
+        unary (table, TOKEN_COMPLEMENT, UNARYOP_COMPLEMENT );
+
+        binary(table, TOKEN_LOG_OR    , BINARYOP_LOGICAL_OR   , 100);
+        binary(table, TOKEN_LOG_AND   , BINARYOP_LOGICAL_AND  , 200);
+        binary(table, TOKEN_EQUAL     , BINARYOP_EQUAL        , 300);
+        binary(table, TOKEN_NOT_EQUAL , BINARYOP_NOT_EQUAL    , 300);
+        binary(table, TOKEN_GEQ       , BINARYOP_GREATER_EQUAL, 400);
+        binary(table, TOKEN_LEQ       , BINARYOP_LESSER_EQUAL , 400);
+        binary(table, TOKEN_GREATER   , BINARYOP_GREATER      , 400);
+        binary(table, TOKEN_LESSER    , BINARYOP_LESSER       , 400);
+        binary(table, TOKEN_BIT_OR    , BINARYOP_BIT_OR       , 500);
+        binary(table, TOKEN_BIT_XOR   , BINARYOP_BIT_XOR      , 500);
+        binary(table, TOKEN_BIT_AND   , BINARYOP_BIT_AND      , 500);
+        binary(table, TOKEN_BIT_LEFT  , BINARYOP_SHIFT_LEFT   , 600);
+        binary(table, TOKEN_BIT_RIGHT , BINARYOP_SHIFT_RIGHT  , 600);
+        binary(table, TOKEN_PLUS      , BINARYOP_ADD          , 700);
+        binary(table, TOKEN_MINUS     , BINARYOP_SUBTRACT     , 700);
+        binary(table, TOKEN_MULTIPLY  , BINARYOP_MULTIPLY     , 800);
+        binary(table, TOKEN_DIVIDE    , BINARYOP_DIVIDE       , 800);
+        binary(table, TOKEN_REMAINDER , BINARYOP_REMAINDER    , 800);
+
+        assign(table, TOKEN_ASSIGN          , ASSIGNOP_ASSIGN          );
+        assign(table, TOKEN_ADD_ASSIGN      , ASSIGNOP_ADD_ASSIGN      );
+        assign(table, TOKEN_SUB_ASSIGN      , ASSIGNOP_SUB_ASSIGN      );
+        assign(table, TOKEN_MUL_ASSIGN      , ASSIGNOP_MUL_ASSIGN      );
+        assign(table, TOKEN_DIV_ASSIGN      , ASSIGNOP_DIV_ASSIGN      );
+        assign(table, TOKEN_REM_ASSIGN      , ASSIGNOP_REM_ASSIGN      );
+        assign(table, TOKEN_AND_ASSIGN      , ASSIGNOP_AND_ASSIGN      );
+        assign(table, TOKEN_OR_ASSIGN       , ASSIGNOP_OR_ASSIGN       );
+        assign(table, TOKEN_XOR_ASSIGN      , ASSIGNOP_XOR_ASSIGN      );
+        assign(table, TOKEN_BIT_RIGHT_ASSIGN, ASSIGNOP_BIT_RIGHT_ASSIGN);
+        assign(table, TOKEN_BIT_LEFT_ASSIGN , ASSIGNOP_BIT_LEFT_ASSIGN );
+
+        return table;
+    }
+
+    const std::array<OperatorInfo, TOKEN_NTOKENS - TOKEN_NONE> ExprNode::optable = make_optable();
 
     std::map<uint16_t, std::string> ExprNode::unopstrmap = {
         {UNARYOP_DEREFERENCE, "$"},
@@ -94,34 +115,13 @@ namespace dmp {
         {ASSIGNOP_BIT_LEFT_ASSIGN , "<<="}
     };
 
-    std::map<int, int> ExprNode::prec = {
-        {TOKEN_LOG_OR    , 100},
-        {TOKEN_LOG_AND   , 200},
-        {TOKEN_EQUAL     , 300},
-        {TOKEN_NOT_EQUAL , 300},
-        {TOKEN_GEQ       , 400},
-        {TOKEN_LEQ       , 400},
-        {TOKEN_GREATER   , 400},
-        {TOKEN_LESSER    , 400},
-        {TOKEN_BIT_OR    , 500},
-        {TOKEN_BIT_XOR   , 500},
-        {TOKEN_BIT_AND   , 500},
-        {TOKEN_BIT_LEFT  , 600},
-        {TOKEN_BIT_RIGHT , 600},
-        {TOKEN_PLUS      , 700},
-        {TOKEN_MINUS     , 700},
-        {TOKEN_MULTIPLY  , 800},
-        {TOKEN_DIVIDE    , 800},
-        {TOKEN_REMAINDER , 800}
-    };
-
     ExprNode::ExprNode(uint16_t t):
         Node(NODE_EXPRNODE),
         is(t)
     {
     }
 
-    AssignExprNode::AssignExprNode(uint16_t o, const std::shared_ptr<Node>& l, const std::shared_ptr<Node>& r):
+    AssignExprNode::AssignExprNode(uint16_t o, Node* l, Node* r):
         ExprNode(EXPR_ASSIGN),
         op(o),
         lhs(l),
@@ -129,7 +129,7 @@ namespace dmp {
     {
     }
 
-    BinaryExprNode::BinaryExprNode(uint16_t o, const std::shared_ptr<Node>& l, const std::shared_ptr<Node>& r):
+    BinaryExprNode::BinaryExprNode(uint16_t o, Node* l, Node* r):
         ExprNode(EXPR_BINARY),
         op(o),
         lhs(l),
@@ -137,14 +137,14 @@ namespace dmp {
     {
     }
 
-    CallExprNode::CallExprNode(const std::shared_ptr<Node>& f, const std::vector<std::shared_ptr<Node> >& a):
+    CallExprNode::CallExprNode(Node* f, const std::vector<Node*>& a):
         ExprNode(EXPR_CALL),
         func(f),
         args(a)
     {
     }
 
-    UnaryExprNode::UnaryExprNode(uint16_t o, const std::shared_ptr<Node>& e):
+    UnaryExprNode::UnaryExprNode(uint16_t o, Node* e):
         ExprNode(EXPR_UNARY),
         op(o),
         exp(e)
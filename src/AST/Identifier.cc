@@ -1,16 +1,19 @@
 #include <AST/Identifier.h>
+#include <Common/Interner.h>
 
 namespace dmp {
 
     Identifier::Identifier():
         Node(NODE_IDENTIFIER),
-        name("")
+        name(""),
+        id(0)
     {
     }
 
     Identifier::Identifier(const std::string& n, const Location& l):
         Node(NODE_IDENTIFIER),
-        name(n)
+        name(n),
+        id(TheInterner->intern(n))
     {
         loc = l;
     }
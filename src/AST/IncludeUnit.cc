@@ -0,0 +1,678 @@
+#include <cstring>
+#include <unordered_map>
+#include <AST/IncludeUnit.h>
+#include <AST/Token.h>
+#include <AST/Identifier.h>
+#include <AST/NameNode.h>
+#include <AST/TypeNode.h>
+#include <AST/ExprNode.h>
+#include <AST/LiteralNode.h>
+#include <AST/Initializer.h>
+#include <AST/Statement.h>
+
+namespace dmp {
+
+    /* A node reference is either null, a back-reference to a node written earlier, or a new node of some kind */
+    enum Node_Ref_ID {
+
+        NODEREF_NULL,
+        NODEREF_BACK,
+        NODEREF_NEW
+
+    };
+
+    IncludeEntry::IncludeEntry(uint16_t i, Node* n):
+        is(i),
+        filename(""),
+        node(n)
+    {
+    }
+
+    IncludeEntry::IncludeEntry(const std::string& f, const Location& l):
+        is(ENTRY_INCLUDE),
+        filename(f),
+        loc(l),
+        node(nullptr)
+    {
+    }
+
+    static inline uint64_t zigzag(int64_t n) {
+        return (uint64_t(n) << 1) ^ uint64_t(n >> 63);
+    }
+
+    static inline int64_t unzigzag(uint64_t n) {
+        return int64_t(n >> 1) ^ -int64_t(n & 1);
+    }
+
+    /*
+    Numbers are written as unsigned LEB128. The lines of a location are written relative to the start line of the
+    previous location, and its end line relative to its start line, so that most of them fit in a byte.
+    */
+    struct UnitWriter {
+
+        std::string out;
+        uint16_t file;
+        uint32_t line;
+        std::unordered_map<const Node*, uint64_t> indices;
+
+        UnitWriter(uint16_t f):
+            file(f),
+            line(0)
+        {
+        }
+
+        void number(uint64_t n) {
+            while (n >= 0x80) {
+                out += char((n & 0x7F) | 0x80);
+                n >>= 7;
+            }
+            out += char(n);
+        }
+
+        void real(double d) {
+            uint64_t bits;
+            std::memcpy(&bits, &d, sizeof(bits));
+            number(bits);
+        }
+
+        void string(const std::string& s) {
+            number(s.size());
+            out += s;
+        }
+
+        void location(const Location& l) {
+            number((zigzag(int64_t(l.start.line) - line) << 1) | (l.file_index == file ? 1 : 0));
+            number(l.start.column);
+            number(zigzag(int64_t(l.end.line) - l.start.line));
+            number(l.end.column);
+            line = l.start.line;
+        }
+
+        void nameNode(const NameNode& nn) {
+            location(nn.loc);
+            node(nn.name);
+            node(nn.node);
+            number(nn.attr);
+        }
+
+        void typeNode(const TypeNode* t) {
+            number(t->is);
+            number(t->attr);
+            switch (t->is) {
+                case TYPE_POINTER :
+                    node(static_cast<const PointerTypeNode*>(t)->points_to);
+                    break;
+                case TYPE_ARRAY :
+                    node(static_cast<const ArrayTypeNode*>(t)->array_of);
+                    node(static_cast<const ArrayTypeNode*>(t)->nelements);
+                    break;
+                case TYPE_STRUCT :
+                    node(static_cast<const StructTypeNode*>(t)->members);
+                    node(static_cast<const StructTypeNode*>(t)->align);
+                    break;
+                case TYPE_UNION :
+                    node(static_cast<const UnionTypeNode*>(t)->members);
+                    break;
+                case TYPE_FUNCTION :
+                    node(static_cast<const FunctionTypeNode*>(t)->args);
+                    node(static_cast<const FunctionTypeNode*>(t)->ret);
+                    break;
+            }
+        }
+
+        void exprNode(const ExprNode* e) {
+            number(e->is);
+            switch (e->is) {
+                case EXPR_UNARY : {
+                    auto ue = static_cast<const UnaryExprNode*>(e);
+                    number(ue->op);
+                    node(ue->exp);
+                    break;
+                }
+                case EXPR_BINARY : {
+                    auto be = static_cast<const BinaryExprNode*>(e);
+                    number(be->op);
+                    node(be->lhs);
+                    node(be->rhs);
+                    break;
+                }
+                case EXPR_ASSIGN : {
+                    auto ae = static_cast<const AssignExprNode*>(e);
+                    number(ae->op);
+                    node(ae->lhs);
+                    node(ae->rhs);
+                    break;
+                }
+                case EXPR_CALL : {
+                    auto ce = static_cast<const CallExprNode*>(e);
+                    node(ce->func);
+                    number(ce->args.size());
+                    for (auto arg : ce->args) {
+                        node(arg);
+                    }
+                    break;
+                }
+                case EXPR_BOOL :
+                    number(static_cast<const BoolNode*>(e)->literal);
+                    break;
+                case EXPR_INT :
+                    number(static_cast<const IntNode*>(e)->literal);
+                    string(static_cast<const IntNode*>(e)->str);
+                    break;
+                case EXPR_REAL :
+                    real(static_cast<const RealNode*>(e)->literal);
+                    string(static_cast<const RealNode*>(e)->str);
+                    break;
+                case EXPR_CHAR :
+                    number(uint8_t(static_cast<const CharNode*>(e)->literal));
+                    string(static_cast<const CharNode*>(e)->str);
+                    break;
+                case EXPR_STRING :
+                    string(static_cast<const StringNode*>(e)->literal);
+                    string(static_cast<const StringNode*>(e)->str);
+                    break;
+            }
+        }
+
+        void statement(const Statement* s) {
+            number(s->is);
+            switch (s->is) {
+                case STATEMENT_RETURN :
+                    node(static_cast<const ReturnStatement*>(s)->val);
+                    break;
+                case STATEMENT_CALL :
+                    node(static_cast<const CallStatement*>(s)->exp);
+                    break;
+                case STATEMENT_ASSIGN :
+                    node(static_cast<const AssignStatement*>(s)->exp);
+                    break;
+                case STATEMENT_DEFINE : {
+                    auto ds = static_cast<const DefineStatement*>(s);
+                    number(ds->storage);
+                    node(ds->name);
+                    node(ds->type);
+                    node(ds->def);
+                    node(ds->align);
+                    break;
+                }
+                case BLOCK_COND :
+                case BLOCK_IF :
+                case BLOCK_LOOP :
+                case BLOCK_FUNCTION : {
+                    auto b = static_cast<const BlockNode*>(s);
+                    node(b->parent);
+                    if (b->is == BLOCK_COND) {
+                        node(static_cast<const CondBlockNode*>(b)->condition);
+                    }
+                    number(b->body.size());
+                    for (auto st : b->body) {
+                        node(st);
+                    }
+                    number(b->symbols.size());
+                    for (const auto& sym : b->symbols) {
+                        node(sym.second);
+                    }
+                    break;
+                }
+            }
+        }
+
+        void node(const Node* n) {
+
+            if (n == nullptr) {
+                number(NODEREF_NULL);
+                return;
+            }
+            auto idx = indices.find(n);
+            if (idx != indices.end()) {
+                number(NODEREF_BACK);
+                number(idx->second);
+                return;
+            }
+
+            auto next = indices.size();
+            indices[n] = next;
+            number(NODEREF_NEW + n->kind);
+            location(n->loc);
+
+            switch (n->kind) {
+                case NODE_TOKEN :
+                    number(static_cast<const Token*>(n)->is);
+                    string(static_cast<const Token*>(n)->str);
+                    break;
+                case NODE_IDENTIFIER :
+                    string(static_cast<const Identifier*>(n)->name);
+                    break;
+                case NODE_NAMENODE :
+                    nameNode(*static_cast<const NameNode*>(n));
+                    break;
+                case NODE_NAMENODESET : {
+                    const auto& set = static_cast<const NameNodeSet*>(n)->set;
+                    number(set.size());
+                    for (const auto& nn : set) {
+                        nameNode(nn);
+                    }
+                    break;
+                }
+                case NODE_TYPENODE :
+                    typeNode(static_cast<const TypeNode*>(n));
+                    break;
+                case NODE_EXPRNODE :
+                    exprNode(static_cast<const ExprNode*>(n));
+                    break;
+                case NODE_STATEMENT :
+                    statement(static_cast<const Statement*>(n));
+                    break;
+                case NODE_NULLINIT :
+                    number(static_cast<const NullInit*>(n)->zero);
+                    break;
+                case NODE_INITIALIZER : {
+                    const auto& elements = static_cast<const Initializer*>(n)->elements;
+                    number(elements.size());
+                    for (const auto& el : elements) {
+                        location(el.loc);
+                        number(el.is);
+                        node(el.tag);
+                        node(el.value);
+                    }
+                    break;
+                }
+            }
+        }
+
+    };
+
+    /*
+    The reader checks the kind of every node it has to cast, so that a damaged blob fails to load rather than
+    producing a malformed AST. A node gets its slot in the back-reference table before its children are read (as
+    the writer numbers it before writing them); the slot is filled once the node is constructed. Blocks are
+    constructed before their bodies, since the blocks nested in them point back to them.
+    */
+    struct UnitReader {
+
+        const char* pos;
+        const char* end;
+        AST* ast;
+        uint16_t file;
+        uint32_t line;
+        std::vector<Node*> nodes;
+        bool valid;
+
+        UnitReader(std::string_view data, AST* a, uint16_t f):
+            pos(data.data()),
+            end(data.data() + data.size()),
+            ast(a),
+            file(f),
+            line(0),
+            valid(true)
+        {
+        }
+
+        uint64_t number() {
+            uint64_t n = 0;
+            for (unsigned shift = 0; shift < 64 && pos != end; shift += 7) {
+                uint8_t b = *pos++;
+                n |= uint64_t(b & 0x7F) << shift;
+                if ((b & 0x80) == 0) {
+                    return n;
+                }
+            }
+            valid = false;
+            return 0;
+        }
+
+        double real() {
+            uint64_t bits = number();
+            double d;
+            std::memcpy(&d, &bits, sizeof(d));
+            return d;
+        }
+
+        std::string string() {
+            auto len = number();
+            if (!valid || len > uint64_t(end - pos)) {
+                valid = false;
+                return "";
+            }
+            std::string s(pos, len);
+            pos += len;
+            return s;
+        }
+
+        Location location() {
+            Location l;
+            auto start = number();
+            if ((start & 1) != 0) {
+                l.file_index = file;
+            }
+            l.start.line = line + unzigzag(start >> 1);
+            l.start.column = number();
+            l.end.line = l.start.line + unzigzag(number());
+            l.end.column = number();
+            line = l.start.line;
+            return l;
+        }
+
+        bool nameNode(NameNode& nn) {
+            nn.loc = location();
+            nn.name = identifier();
+            nn.node = node();
+            nn.attr = number();
+            return valid;
+        }
+
+        Node* check(Node* n, bool ok) {
+            if (n != nullptr && !ok) {
+                valid = false;
+            }
+            return valid ? n : nullptr;
+        }
+
+        Identifier* identifier() {
+            auto n = node();
+            return static_cast<Identifier*>(check(n, n && n->kind == NODE_IDENTIFIER));
+        }
+
+        NameNodeSet* nameNodeSet() {
+            auto n = node();
+            return static_cast<NameNodeSet*>(check(n, n && n->kind == NODE_NAMENODESET));
+        }
+
+        ExprNode* exprNode(uint16_t is) {
+            auto n = node();
+            return static_cast<ExprNode*>(check(n, n && n->kind == NODE_EXPRNODE && static_cast<ExprNode*>(n)->is == is));
+        }
+
+        Statement* statement() {
+            auto n = node();
+            return static_cast<Statement*>(check(n, n && n->kind == NODE_STATEMENT));
+        }
+
+        BlockNode* block() {
+            auto s = statement();
+            return static_cast<BlockNode*>(check(s, s && s->is >= BLOCK_COND && s->is <= BLOCK_FUNCTION));
+        }
+
+        Node* typeNode() {
+            auto is = number();
+            auto attr = number();
+            TypeNode* t = nullptr;
+            switch (is) {
+                case TYPE_UNKNOWN :
+                    t = ast->make<UnknownTypeNode>();
+                    break;
+                case TYPE_VOID :
+                    t = ast->make<VoidTypeNode>();
+                    break;
+                case TYPE_POINTER :
+                    t = ast->make<PointerTypeNode>(node());
+                    break;
+                case TYPE_ARRAY : {
+                    auto array_of = node();
+                    t = ast->make<ArrayTypeNode>(array_of, node());
+                    break;
+                }
+                case TYPE_STRUCT : {
+                    auto members = nameNodeSet();
+                    t = ast->make<StructTypeNode>(members, false, node());
+                    break;
+                }
+                case TYPE_UNION :
+                    t = ast->make<UnionTypeNode>(nameNodeSet());
+                    break;
+                case TYPE_FUNCTION : {
+                    auto args = nameNodeSet();
+                    t = ast->make<FunctionTypeNode>(args, node());
+                    break;
+                }
+                default :
+                    if (is > TYPE_VOID && is < TYPE_POINTER) {
+                        t = ast->make<PrimitiveTypeNode>(is);
+                    }
+            }
+            if (t != nullptr) {
+                t->attr = attr;
+            }
+            return t;
+        }
+
+        Node* exprNode() {
+            auto is = number();
+            switch (is) {
+                case EXPR_UNARY : {
+                    auto op = number();
+                    return ast->make<UnaryExprNode>(op, node());
+                }
+                case EXPR_BINARY : {
+                    auto op = number();
+                    auto lhs = node();
+                    return ast->make<BinaryExprNode>(op, lhs, node());
+                }
+                case EXPR_ASSIGN : {
+                    auto op = number();
+                    auto lhs = node();
+                    return ast->make<AssignExprNode>(op, lhs, node());
+                }
+                case EXPR_CALL : {
+                    auto func = node();
+                    std::vector<Node*> args;
+                    for (auto nargs = number(); valid && args.size() < nargs; ) {
+                        args.push_back(node());
+                    }
+                    return ast->make<CallExprNode>(func, args);
+                }
+                case EXPR_BOOL :
+                    return ast->make<BoolNode>(Token(), number() != 0);
+                case EXPR_INT : {
+                    auto i = number();
+                    return ast->make<IntNode>(Token(TOKEN_INT, string(), Location()), i);
+                }
+                case EXPR_REAL : {
+                    auto d = real();
+                    return ast->make<RealNode>(Token(TOKEN_REAL, string(), Location()), d);
+                }
+                case EXPR_CHAR : {
+                    auto c = char(number());
+                    return ast->make<CharNode>(Token(TOKEN_CHAR, string(), Location()), c);
+                }
+                case EXPR_STRING : {
+                    auto s = string();
+                    return ast->make<StringNode>(Token(TOKEN_STRING, string(), Location()), s);
+                }
+            }
+            return nullptr;
+        }
+
+        Node* statement(std::size_t slot) {
+            auto is = number();
+            switch (is) {
+                case STATEMENT_CONTINUE :
+                    return ast->make<ContinueStatement>();
+                case STATEMENT_BREAK :
+                    return ast->make<BreakStatement>();
+                case STATEMENT_RETURN :
+                    return ast->make<ReturnStatement>(node());
+                case STATEMENT_CALL : {
+                    auto exp = exprNode(EXPR_CALL);
+                    return exp ? ast->make<CallStatement>(static_cast<CallExprNode*>(exp)) : nullptr;
+                }
+                case STATEMENT_ASSIGN : {
+                    auto exp = exprNode(EXPR_ASSIGN);
+                    return exp ? ast->make<AssignStatement>(static_cast<AssignExprNode*>(exp)) : nullptr;
+                }
+                case STATEMENT_DEFINE : {
+                    auto storage = number();
+                    auto name = identifier();
+                    auto type = node();
+                    auto def = node();
+                    auto align = node();
+                    if (name == nullptr || def == nullptr) {
+                        return nullptr;
+                    }
+                    return ast->make<DefineStatement>(storage, name, type, def, align);
+                }
+                case BLOCK_COND :
+                case BLOCK_IF :
+                case BLOCK_LOOP :
+                case BLOCK_FUNCTION : {
+                    auto b = (is == BLOCK_COND ? ast->make<CondBlockNode>(nullptr) : ast->make<BlockNode>(is));
+                    nodes[slot] = b;
+                    b->parent = block();
+                    if (is == BLOCK_COND) {
+                        static_cast<CondBlockNode*>(b)->condition = node();
+                    }
+                    for (auto nbody = number(); valid && b->body.size() < nbody; ) {
+                        b->body.push_back(statement());
+                    }
+                    for (auto nsyms = number(); valid && b->symbols.size() < nsyms; ) {
+                        auto sym = identifier();
+                        if (sym == nullptr || b->symbols.count(sym->id) > 0) {
+                            valid = false;
+                            break;
+                        }
+                        b->symbols[sym->id] = sym;
+                    }
+                    return b;
+                }
+            }
+            return nullptr;
+        }
+
+        Node* node() {
+
+            auto ref = number();
+            if (!valid || ref == NODEREF_NULL) {
+                return nullptr;
+            }
+            if (ref == NODEREF_BACK) {
+                auto idx = number();
+                if (idx >= nodes.size() || nodes[idx] == nullptr) {
+                    valid = false;
+                    return nullptr;
+                }
+                return nodes[idx];
+            }
+
+            auto slot = nodes.size();
+            nodes.push_back(nullptr);
+            auto loc = location();
+
+            Node* n = nullptr;
+            switch (ref - NODEREF_NEW) {
+                case NODE_TOKEN : {
+                    auto is = number();
+                    n = ast->make<Token>(is, string(), loc);
+                    break;
+                }
+                case NODE_IDENTIFIER :
+                    n = ast->make<Identifier>(string(), loc);
+                    break;
+                case NODE_NAMENODE : {
+                    auto nn = ast->make<NameNode>();
+                    nameNode(*nn);
+                    n = nn;
+                    break;
+                }
+                case NODE_NAMENODESET : {
+                    auto nset = ast->make<NameNodeSet>();
+                    for (auto size = number(); valid && nset->set.size() < size; ) {
+                        nset->set.emplace_back();
+                        nameNode(nset->set.back());
+                    }
+                    n = nset;
+                    break;
+                }
+                case NODE_TYPENODE :
+                    n = typeNode();
+                    break;
+                case NODE_EXPRNODE :
+                    n = exprNode();
+                    break;
+                case NODE_STATEMENT :
+                    n = statement(slot);
+                    break;
+                case NODE_NULLINIT :
+                    n = ast->make<NullInit>(number() != 0);
+                    break;
+                case NODE_INITIALIZER : {
+                    std::vector<InitElement> elements;
+                    for (auto size = number(); valid && elements.size() < size; ) {
+                        auto eloc = location();
+                        auto is = number();
+                        auto tag = node();
+                        auto value = node();
+                        if (value == nullptr) {
+                            valid = false;
+                            break;
+                        }
+                        elements.emplace_back(value);
+                        elements.back().is = is;
+                        elements.back().tag = tag;
+                        elements.back().loc = eloc;
+                    }
+                    n = ast->make<Initializer>(elements);
+                    break;
+                }
+            }
+
+            if (!valid || n == nullptr) {
+                valid = false;
+                return nullptr;
+            }
+            n->loc = loc;
+            nodes[slot] = n;
+            return n;
+        }
+
+    };
+
+    std::string IncludeUnit::serialize(uint16_t file) const {
+
+        UnitWriter writer(file);
+        writer.number(entries.size());
+        for (const auto& entry : entries) {
+            writer.number(entry.is);
+            if (entry.is == ENTRY_INCLUDE) {
+                writer.string(entry.filename);
+                writer.location(entry.loc);
+            }
+            else {
+                writer.node(entry.node);
+            }
+        }
+        return writer.out;
+    }
+
+    bool IncludeUnit::deserialize(std::string_view data, AST* ast, uint16_t file) {
+
+        UnitReader reader(data, ast, file);
+        entries.clear();
+
+        for (auto size = reader.number(); reader.valid && entries.size() < size; ) {
+            auto is = reader.number();
+            if (is == ENTRY_INCLUDE) {
+                auto filename = reader.string();
+                entries.emplace_back(filename, reader.location());
+                continue;
+            }
+            auto n = reader.node();
+            if (is == ENTRY_REPRESENTATION || is == ENTRY_DECLARATION) {
+                reader.check(n, n && n->kind == NODE_NAMENODE && static_cast<NameNode*>(n)->name != nullptr);
+            }
+            else if (is == ENTRY_DEFINITION) {
+                reader.check(n, n && n->kind == NODE_STATEMENT && static_cast<Statement*>(n)->is == STATEMENT_DEFINE);
+            }
+            if (n == nullptr || is > ENTRY_DEFINITION) {
+                reader.valid = false;
+            }
+            entries.emplace_back(is, n);
+        }
+
+        if (!reader.valid || reader.pos != reader.end) {
+            entries.clear();
+            return false;
+        }
+        return true;
+    }
+
+}
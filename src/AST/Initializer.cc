@@ -2,16 +2,16 @@
 
 namespace dmp {
 
-    InitElement::InitElement(const std::shared_ptr<Node>& v):
+    InitElement::InitElement(Node* v):
         Node(NODE_INITELEMENT),
         is(INIT_UNTAGGED),
-        tag(),
+        tag(nullptr),
         value(v)
     {
         loc = v->loc;
     }
 
-    InitElement::InitElement(uint16_t tt, const std::shared_ptr<Node>& t, const std::shared_ptr<Node>& v):
+    InitElement::InitElement(uint16_t tt, Node* t, Node* v):
         Node(NODE_INITELEMENT),
         is(tt),
         tag(t),
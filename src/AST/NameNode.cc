@@ -4,27 +4,31 @@ namespace dmp {
 
     NameNode::NameNode():
         Node(NODE_NAMENODE),
+        name(nullptr),
+        node(nullptr),
         attr(0)
     {
     }
     
-    NameNode::NameNode(const std::shared_ptr<Node>& nd):
+    NameNode::NameNode(Node* nd):
         Node(NODE_NAMENODE),
+        name(nullptr),
         node(nd),
         attr(0)
     {
         loc = nd->loc;
     }
     
-    NameNode::NameNode(const std::shared_ptr<Node>& nd, uint64_t a):
+    NameNode::NameNode(Node* nd, uint64_t a):
         Node(NODE_NAMENODE),
+        name(nullptr),
         node(nd),
         attr(a)
     {
         loc = nd->loc;
     }
     
-    NameNode::NameNode(const std::shared_ptr<Identifier>& nm, const std::shared_ptr<Node>& nd):
+    NameNode::NameNode(Identifier* nm, Node* nd):
         Node(NODE_NAMENODE),
         name(nm),
         node(nd),
@@ -34,7 +38,7 @@ namespace dmp {
         loc.end = nd->loc.end;
     }
 
-    NameNode::NameNode(const std::shared_ptr<Identifier>& nm, const std::shared_ptr<Node>& nd, uint64_t a):
+    NameNode::NameNode(Identifier* nm, Node* nd, uint64_t a):
         Node(NODE_NAMENODE),
         name(nm),
         node(nd),
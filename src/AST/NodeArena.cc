@@ -0,0 +1,34 @@
+#include <cstdint>
+#include <AST/NodeArena.h>
+
+namespace dmp {
+
+    NodeArena::NodeArena():
+        next(nullptr),
+        end(nullptr)
+    {
+    }
+
+    NodeArena::~NodeArena() {
+        for (std::size_t i = nodes.size(); i > 0; i--) {
+            nodes[i-1]->~Node();
+        }
+    }
+
+    void* NodeArena::allocate(std::size_t size, std::size_t align) {
+        auto addr = reinterpret_cast<std::uintptr_t>(next);
+        auto offset = (align - addr % align) % align;
+        if (next == nullptr || size + offset > std::size_t(end - next)) {
+            std::size_t n = size + align > chunk_size ? size + align : chunk_size;
+            chunks.push_back(std::unique_ptr<char[]>(new char[n]));
+            next = chunks.back().get();
+            end = next + n;
+            addr = reinterpret_cast<std::uintptr_t>(next);
+            offset = (align - addr % align) % align;
+        }
+        void* mem = next + offset;
+        next += offset + size;
+        return mem;
+    }
+
+}
@@ -18,45 +18,47 @@ namespace dmp {
     {
     }
 
-    ReturnStatement::ReturnStatement(const std::shared_ptr<Node>& v):
+    ReturnStatement::ReturnStatement(Node* v):
         Statement(STATEMENT_RETURN),
         val(v)
     {
     }
 
-    CallStatement::CallStatement(const std::shared_ptr<CallExprNode>& ce):
+    CallStatement::CallStatement(CallExprNode* ce):
         Statement(STATEMENT_CALL),
         exp(ce)
     {
         loc = ce->loc;
     }
 
-    AssignStatement::AssignStatement(const std::shared_ptr<AssignExprNode>& ae):
+    AssignStatement::AssignStatement(AssignExprNode* ae):
         Statement(STATEMENT_ASSIGN),
         exp(ae)
     {
         loc = ae->loc;
     }
 
-    DefineStatement::DefineStatement(uint16_t s, const std::shared_ptr<Identifier>& n, const std::shared_ptr<Node>& t, const std::shared_ptr<Node>& d):
+    DefineStatement::DefineStatement(uint16_t s, Identifier* n, Node* t, Node* d, Node* a):
         Statement(STATEMENT_DEFINE),
         storage(s),
         name(n),
         type(t),
-        def(d)
+        def(d),
+        align(a)
     {
         loc = name->loc;
         loc.end = def->loc.end;
     }
 
-    BlockNode::BlockNode(uint16_t t, const std::shared_ptr<BlockNode>& p):
+    BlockNode::BlockNode(uint16_t t, BlockNode* p):
         Statement(t),
         parent(p)
     {
     }
 
-    CondBlockNode::CondBlockNode(const std::shared_ptr<BlockNode>& p):
-        BlockNode(BLOCK_COND, p)
+    CondBlockNode::CondBlockNode(BlockNode* p):
+        BlockNode(BLOCK_COND, p),
+        condition(nullptr)
     {
     }
 
@@ -23,22 +23,23 @@ namespace dmp {
     {
     }
 
-    PointerTypeNode::PointerTypeNode(const std::shared_ptr<Node>& pt):
+    PointerTypeNode::PointerTypeNode(Node* pt):
         TypeNode(TYPE_POINTER),
         points_to(pt)
     {
     }
 
-    ArrayTypeNode::ArrayTypeNode(const std::shared_ptr<Node>& ao, const std::shared_ptr<Node>& ne):
+    ArrayTypeNode::ArrayTypeNode(Node* ao, Node* ne):
         TypeNode(TYPE_ARRAY),
         array_of(ao),
         nelements(ne)
     {
     }
 
-    StructTypeNode::StructTypeNode(const std::shared_ptr<NameNodeSet>& m, bool p):
+    StructTypeNode::StructTypeNode(NameNodeSet* m, bool p, Node* a):
         TypeNode(TYPE_STRUCT),
-        members(m)
+        members(m),
+        align(a)
     {
         if (p) {
             attr |= 1;
@@ -49,13 +50,13 @@ namespace dmp {
         return (attr & 1) > 0;
     }
 
-    UnionTypeNode::UnionTypeNode(const std::shared_ptr<NameNodeSet>& m):
+    UnionTypeNode::UnionTypeNode(NameNodeSet* m):
         TypeNode(TYPE_UNION),
         members(m)
     {
     }
 
-    FunctionTypeNode::FunctionTypeNode(const std::shared_ptr<NameNodeSet>& a, const std::shared_ptr<Node>& r):
+    FunctionTypeNode::FunctionTypeNode(NameNodeSet* a, Node* r):
         TypeNode(TYPE_FUNCTION),
         args(a),
         ret(r)
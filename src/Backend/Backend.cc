@@ -1,42 +1,131 @@
+#include <map>
+#include <mutex>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/MC/TargetRegistry.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Target/TargetOptions.h>
 #include <llvm/TargetParser/Host.h>
+#include <llvm/TargetParser/Triple.h>
 #include <llvm/IR/LegacyPassManager.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Passes/OptimizationLevel.h>
 
-#include <common/Globals.h>
+#include <Common/Globals.h>
 #include <Backend/Backend.h>
 
 namespace dmp {
 
-    Backend::Backend(const std::string& src, const std::string& out): 
-        Pass(nullptr, nullptr, nullptr),
-        srcfile(src),
-        outfile(out)
-    {
-    
+    /*
+    The target registry, the host triple and the host CPU are process-wide. They are set up by the first backend that
+    is created (the initialization of a function-local static is thread-safe) and shared by all compilations after that.
+    Only the native target is registered here; see HostTarget::lookup for the others.
+    */
+    const HostTarget& HostTarget::get() {
+
+        static const HostTarget host = []() {
+            llvm::InitializeNativeTarget();
+            llvm::InitializeNativeTargetAsmParser();
+            llvm::InitializeNativeTargetAsmPrinter();
+
+            HostTarget ht;
+            ht.triple = llvm::sys::getDefaultTargetTriple();
+            ht.cpu = llvm::sys::getHostCPUName().str();
+            ht.target = llvm::TargetRegistry::lookupTarget(ht.triple, ht.error_msg);
+            return ht;
+        }();
+
+        return host;
+    }
+
+    /*
+    Find the target for a triple other than the host's. The native target covers e.g. another OS on the same
+    architecture. Otherwise every other target is registered, once, when dimple is built with all the LLVM targets
+    (DIMPLE_ALL_TARGETS); a plain build only links the native one.
+    */
+    const llvm::Target* HostTarget::lookup(const std::string& triple, std::string& error_msg) {
+
+        static std::mutex registry;
+        static bool all = false;
+
+        get();
+        std::lock_guard<std::mutex> lock(registry);
+
+        std::string native_error;
+        auto target = llvm::TargetRegistry::lookupTarget(triple, native_error);
+        if (target || all) {
+            error_msg = native_error;
+            return target;
+        }
+
+#ifdef DIMPLE_ALL_TARGETS
         llvm::InitializeAllTargetInfos();
         llvm::InitializeAllTargets();
         llvm::InitializeAllTargetMCs();
         llvm::InitializeAllAsmParsers();
         llvm::InitializeAllAsmPrinters();
-        
-        auto triple = llvm::sys::getDefaultTargetTriple();
-        std::string error_msg;
-        auto target = llvm::TargetRegistry::lookupTarget(triple, error_msg);
+        all = true;
+        return llvm::TargetRegistry::lookupTarget(triple, error_msg);
+#else
+        error_msg = "Target " + triple + " is not available; dimple only supports the native target unless it is built with TARGETS=all";
+        return nullptr;
+#endif
+    }
+
+    /*
+    Target machines are kept per thread, for each triple and optimization level. A thread that compiles one file after
+    another (a -j worker, or a worker of the compile server) creates its machine only once
+    */
+    static llvm::TargetMachine* targetMachine(const llvm::Target* target, const std::string& triple, const std::string& CPU, uint16_t optlevel) {
+
+        static thread_local std::map<std::pair<std::string, uint16_t>, std::unique_ptr<llvm::TargetMachine> > machines;
+
+        auto& machine = machines[std::make_pair(triple, optlevel)];
+        if (!machine) {
+            auto features = "";
+            llvm::TargetOptions options;
+            auto reloc_model = std::optional<llvm::Reloc::Model>();
+
+            machine.reset(target->createTargetMachine(triple, CPU, features, options, reloc_model));
+            if (!machine) {
+                return nullptr;
+            }
+            switch (optlevel) {
+                case OPT_LEVEL_O0: machine->setOptLevel(llvm::CodeGenOptLevel::None); break;
+                case OPT_LEVEL_O1: machine->setOptLevel(llvm::CodeGenOptLevel::Less); break;
+                case OPT_LEVEL_O3: machine->setOptLevel(llvm::CodeGenOptLevel::Aggressive); break;
+                default          : machine->setOptLevel(llvm::CodeGenOptLevel::Default);
+            }
+        }
+        return machine.get();
+    }
+
+    Backend::Backend(const std::string& src, const std::string& out, uint16_t opt, uint16_t kind, const std::string& tt): 
+        Pass(nullptr, nullptr, nullptr),
+        machine(nullptr),
+        srcfile(src),
+        outfile(out),
+        optlevel(opt),
+        outputkind(kind)
+    {
+        const auto& host = HostTarget::get();
+        auto triple = host.triple;
+        auto CPU = host.cpu;
+        auto target = host.target;
+        auto error_msg = host.error_msg;
+
+        if (!tt.empty() && llvm::Triple::normalize(tt) != llvm::Triple::normalize(host.triple)) {
+            triple = llvm::Triple::normalize(tt);
+            CPU = "generic";
+            target = HostTarget::lookup(triple, error_msg);
+        }
 
         if (!target) {
             error(error_msg);
         }
         else {
-            auto CPU = llvm::sys::getHostCPUName();
-            auto features = "";
-            llvm::TargetOptions options;
-            auto reloc_model = std::optional<llvm::Reloc::Model>();
-            
-            machine = target->createTargetMachine(triple, CPU, features, options, reloc_model);
+            machine = targetMachine(target, triple, CPU, optlevel);
 
             if (machine == nullptr) {
                 error("Unable to detect target machine");
@@ -55,24 +144,85 @@ namespace dmp {
             return error();
         }
 
-        TheModule->print(llvm::outs(), nullptr);
+        if (!optimize()) {
+            return error();
+        }
+
+        auto flags = llvm::sys::fs::OF_None;
+        if (outputkind == OUTPUT_ASSEMBLY || outputkind == OUTPUT_LLVM_IR) {
+            flags = llvm::sys::fs::OF_Text;
+        }
 
-        auto outfiletype = llvm::CGFT_ObjectFile;
-    
         std::error_code EC;
-        llvm::raw_fd_ostream dest(outfile, EC, llvm::sys::fs::OF_None);
+        llvm::raw_fd_ostream dest(outfile, EC, flags);
         if (EC) {
             return error("Unable to open " + outfile + "; " + EC.message());
         }        
 
+        if (!emit(dest)) {
+            return error();
+        }
+        dest.flush();
+        return success();
+    }
+
+    bool Backend::emit(llvm::raw_pwrite_stream& dest) {
+
+        if (outputkind == OUTPUT_LLVM_IR) {
+            TheModule->print(dest, nullptr);
+            return true;
+        }
+
+        if (outputkind == OUTPUT_BITCODE) {
+            llvm::WriteBitcodeToFile(*TheModule, dest);
+            return true;
+        }
+
+        auto outfiletype = llvm::CodeGenFileType::ObjectFile;
+        if (outputkind == OUTPUT_ASSEMBLY) {
+            outfiletype = llvm::CodeGenFileType::AssemblyFile;
+        }
+
         llvm::legacy::PassManager pass;
         if (machine->addPassesToEmitFile(pass, dest, nullptr, outfiletype)) {
-            return error("Unable to produce object file");
+            return error(outputkind == OUTPUT_ASSEMBLY ? "Unable to produce assembly file" : "Unable to produce object file");
         }
         
         pass.run(*TheModule);
-        dest.flush();
-        return success();
+        return true;
+    }
+
+    bool Backend::optimize() {
+
+        if (optlevel == OPT_LEVEL_O0) {
+            return true;
+        }
+
+        llvm::OptimizationLevel level;
+        switch (optlevel) {
+            case OPT_LEVEL_O1: level = llvm::OptimizationLevel::O1; break;
+            case OPT_LEVEL_O2: level = llvm::OptimizationLevel::O2; break;
+            case OPT_LEVEL_O3: level = llvm::OptimizationLevel::O3; break;
+            case OPT_LEVEL_OS: level = llvm::OptimizationLevel::Os; break;
+            case OPT_LEVEL_OZ: level = llvm::OptimizationLevel::Oz; break;
+            default          : return error("Unknown optimization level");
+        }
+
+        llvm::LoopAnalysisManager LAM;
+        llvm::FunctionAnalysisManager FAM;
+        llvm::CGSCCAnalysisManager CGAM;
+        llvm::ModuleAnalysisManager MAM;
+
+        llvm::PassBuilder builder(machine);
+        builder.registerModuleAnalyses(MAM);
+        builder.registerCGSCCAnalyses(CGAM);
+        builder.registerFunctionAnalyses(FAM);
+        builder.registerLoopAnalyses(LAM);
+        builder.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+
+        auto MPM = builder.buildPerModuleDefaultPipeline(level);
+        MPM.run(*TheModule, MAM);
+        return true;
     }
 
 }
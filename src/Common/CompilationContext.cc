@@ -0,0 +1,34 @@
+#include <Common/CompilationContext.h>
+#include <Common/Interner.h>
+#include <IR/TypeContext.h>
+#include <IR/StringPool.h>
+
+namespace dmp {
+
+    CompilationContext::CompilationContext(const std::string& name):
+        context(std::make_unique<llvm::LLVMContext>()),
+        module(std::make_unique<llvm::Module>(name, *context)),
+        builder(std::make_unique<llvm::IRBuilder<> >(*context)),
+        interner(std::make_unique<Interner>()),
+        types(std::make_unique<TypeContext>()),
+        strings(std::make_unique<StringPool>())
+    {
+        TheContext     = context.get();
+        TheModule      = module.get();
+        TheBuilder     = builder.get();
+        TheInterner    = interner.get();
+        TheTypeContext = types.get();
+        TheStringPool  = strings.get();
+    }
+
+    /* The members are destroyed in reverse order, so the LLVM context goes last */
+    CompilationContext::~CompilationContext() {
+        TheStringPool  = nullptr;
+        TheTypeContext = nullptr;
+        TheInterner    = nullptr;
+        TheBuilder     = nullptr;
+        TheModule      = nullptr;
+        TheContext     = nullptr;
+    }
+
+}
@@ -2,8 +2,8 @@
 
 namespace dmp {
 
-    std::unique_ptr<llvm::LLVMContext> TheContext;
-    std::unique_ptr<llvm::Module> TheModule;
-    std::unique_ptr<llvm::IRBuilder<> > TheBuilder;
+    thread_local llvm::LLVMContext* TheContext = nullptr;
+    thread_local llvm::Module* TheModule = nullptr;
+    thread_local llvm::IRBuilder<>* TheBuilder = nullptr;
 
 }
@@ -0,0 +1,37 @@
+#include <algorithm>
+#include <Common/Interner.h>
+
+namespace dmp {
+
+    thread_local Interner* TheInterner = nullptr;
+
+    Interner::Interner() {
+        intern("");
+    }
+
+    uint32_t Interner::intern(std::string_view s) {
+        auto it = ids.find(s);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        uint32_t id = strings.size();
+        strings.emplace_back(s);
+        ids.emplace(strings.back(), id);
+        return id;
+    }
+
+    const std::string& Interner::str(uint32_t id) const {
+        return strings[id];
+    }
+
+    std::size_t Interner::size() const {
+        return strings.size();
+    }
+
+    void Interner::sort(std::vector<uint32_t>& v) const {
+        std::sort(v.begin(), v.end(), [this](uint32_t a, uint32_t b) {
+            return strings[a] < strings[b];
+        });
+    }
+
+}
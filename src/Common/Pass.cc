@@ -7,7 +7,8 @@ namespace dmp {
     Pass<T>::Pass(InputManager* in, AST* tree, GST* sym):
         input(in),
         ast(tree),
-        gst(sym)
+        gst(sym),
+        result()
     {
     }
 
@@ -34,25 +35,20 @@ namespace dmp {
     }
 
     template<typename T>
-    bool Pass<T>::error(const Node& node, const std::string& msg) {
-        errors.push_back(Error(node.loc, msg));
+    bool Pass<T>::error(const Location& loc, const std::string& msg) {
+        errors.push_back(Error(loc, msg));
         return error();
     }
 
     template<typename T>
-    bool Pass<T>::error(const Node* node, const std::string& msg) {
-        if (node != nullptr) {
-            errors.push_back(Error(node->loc, msg));
-        }
-        else {
-            errors.push_back(Error(msg));
-        }
+    bool Pass<T>::error(const Node& node, const std::string& msg) {
+        errors.push_back(Error(node.loc, msg));
         return error();
     }
 
     template<typename T>
-    bool Pass<T>::error(const std::shared_ptr<Node>& node, const std::string& msg) {
-        if (node) {
+    bool Pass<T>::error(const Node* node, const std::string& msg) {
+        if (node != nullptr) {
             errors.push_back(Error(node->loc, msg));
         }
         else {
@@ -75,7 +71,7 @@ namespace dmp {
         return err;
     }
 
-    template struct Pass<Node>;
-    template struct Pass<Entity>;
-    template struct Pass<void>;
+    template struct Pass<Node*>;
+    template struct Pass<std::shared_ptr<Entity> >;
+    template struct Pass<std::shared_ptr<void> >;
 }
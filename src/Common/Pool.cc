@@ -0,0 +1,48 @@
+#include <Common/Pool.h>
+
+namespace dmp {
+
+    Pool::Pool():
+        free_lists(),
+        next(nullptr),
+        end(nullptr)
+    {
+    }
+
+    void* Pool::allocate(std::size_t size) {
+        std::size_t c = (size + granularity - 1) / granularity;
+        if (c == 0 || c > nclasses) {
+            return ::operator new(size);
+        }
+        if (free_lists[c-1] != nullptr) {
+            void* mem = free_lists[c-1];
+            free_lists[c-1] = *static_cast<void**>(mem);
+            return mem;
+        }
+        std::size_t bytes = c * granularity;
+        if (next == nullptr || bytes > std::size_t(end - next)) {
+            chunks.push_back(std::unique_ptr<char[]>(new char[chunk_size]));
+            next = chunks.back().get();
+            end = next + chunk_size;
+        }
+        void* mem = next;
+        next += bytes;
+        return mem;
+    }
+
+    void Pool::deallocate(void* mem, std::size_t size) {
+        std::size_t c = (size + granularity - 1) / granularity;
+        if (c == 0 || c > nclasses) {
+            ::operator delete(mem);
+            return;
+        }
+        *static_cast<void**>(mem) = free_lists[c-1];
+        free_lists[c-1] = mem;
+    }
+
+    Pool& Pool::local() {
+        static thread_local Pool pool;
+        return pool;
+    }
+
+}
@@ -0,0 +1,176 @@
+#include <mutex>
+#include <cstdio>
+#include <cstring>
+#include <cinttypes>
+#include <unordered_map>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/xxhash.h>
+#include <IO/IncludeCache.h>
+#include <AST/IncludeUnit.h>
+
+namespace dmp {
+
+    struct IncludeCacheHeader {
+
+        char magic[4];
+        uint32_t format;
+        uint64_t version;
+        uint64_t source_hash;
+        uint64_t source_size;
+        uint64_t payload_hash;
+
+    };
+
+    static const char include_cache_magic[4] = {'D', 'M', 'P', 'C'};
+
+    /*
+    The in-memory store holds one blob per include file (by absolute path), the one for its latest contents, so that
+    a long running process (e.g. a compile server whose sources keep being edited) does not accumulate stale blobs
+    */
+    struct MemoryEntry {
+
+        std::string key;
+        std::shared_ptr<llvm::MemoryBuffer> blob;
+
+    };
+
+    static std::mutex memory_mutex;
+    static std::unordered_map<std::string, MemoryEntry> memory;
+
+    static std::string absolutePath(const std::string& path) {
+        llvm::SmallString<256> p(path);
+        llvm::sys::fs::make_absolute(p);
+        llvm::sys::path::remove_dots(p, true);
+        return std::string(p.str());
+    }
+
+    /* A rebuilt compiler may parse differently, so the executable itself is part of the version */
+    static uint64_t compilerVersion() {
+        static const uint64_t version = [] {
+            std::string v = "DIMPLE AST format " + std::to_string(IncludeUnit::format_version);
+            auto exe = llvm::sys::fs::getMainExecutable(nullptr, nullptr);
+            llvm::sys::fs::file_status status;
+            if (!exe.empty() && !llvm::sys::fs::status(exe, status)) {
+                v += " " + exe;
+                v += " " + std::to_string(status.getSize());
+                v += " " + std::to_string(status.getLastModificationTime().time_since_epoch().count());
+            }
+            return llvm::xxHash64(v);
+        }();
+        return version;
+    }
+
+    static std::string cacheKey(uint64_t source_hash) {
+        char key[33];
+        std::snprintf(key, sizeof(key), "%016" PRIx64 "%016" PRIx64, source_hash, compilerVersion());
+        return key;
+    }
+
+    static bool isValid(const llvm::MemoryBuffer& blob, llvm::StringRef source, uint64_t source_hash) {
+        IncludeCacheHeader header;
+        if (blob.getBufferSize() < sizeof(header)) {
+            return false;
+        }
+        std::memcpy(&header, blob.getBufferStart(), sizeof(header));
+        return std::memcmp(header.magic, include_cache_magic, sizeof(header.magic)) == 0 &&
+               header.format == IncludeUnit::format_version &&
+               header.version == compilerVersion() &&
+               header.source_hash == source_hash &&
+               header.source_size == source.size() &&
+               header.payload_hash == llvm::xxHash64(llvm::StringRef(IncludeCache::contents(blob)));
+    }
+
+    IncludeCache::IncludeCache(const std::string& dir, bool mem):
+        directory(dir),
+        inmemory(mem)
+    {
+    }
+
+    std::string_view IncludeCache::contents(const llvm::MemoryBuffer& blob) {
+        return std::string_view(blob.getBufferStart() + sizeof(IncludeCacheHeader), blob.getBufferSize() - sizeof(IncludeCacheHeader));
+    }
+
+    std::shared_ptr<llvm::MemoryBuffer> IncludeCache::load(const std::string& filepath, llvm::StringRef source) const {
+
+        std::shared_ptr<llvm::MemoryBuffer> blob;
+
+        auto source_hash = llvm::xxHash64(source);
+        auto key = cacheKey(source_hash);
+        auto path = absolutePath(filepath);
+
+        if (inmemory) {
+            std::lock_guard<std::mutex> lock(memory_mutex);
+            auto entry = memory.find(path);
+            if (entry != memory.end() && entry->second.key == key) {
+                blob = entry->second.blob;
+            }
+        }
+        if (blob && !isValid(*blob, source, source_hash)) {
+            blob.reset();
+        }
+
+        if (!blob && !directory.empty()) {
+            llvm::SmallString<256> cachefile(directory);
+            llvm::sys::path::append(cachefile, key + ".dmpc");
+            auto file = llvm::MemoryBuffer::getFile(cachefile, false, false);
+            if (file && isValid(**file, source, source_hash)) {
+                blob = std::move(*file);
+                if (inmemory) {
+                    std::lock_guard<std::mutex> lock(memory_mutex);
+                    memory[path] = MemoryEntry{key, blob};
+                }
+            }
+        }
+
+        return blob;
+    }
+
+    void IncludeCache::store(const std::string& filepath, llvm::StringRef source, const std::string& unit) const {
+
+        IncludeCacheHeader header;
+        std::memcpy(header.magic, include_cache_magic, sizeof(header.magic));
+        header.format = IncludeUnit::format_version;
+        header.version = compilerVersion();
+        header.source_hash = llvm::xxHash64(source);
+        header.source_size = source.size();
+        header.payload_hash = llvm::xxHash64(unit);
+
+        auto key = cacheKey(header.source_hash);
+        std::string blob(reinterpret_cast<const char*>(&header), sizeof(header));
+        blob += unit;
+
+        if (inmemory) {
+            std::lock_guard<std::mutex> lock(memory_mutex);
+            memory[absolutePath(filepath)] = MemoryEntry{key, llvm::MemoryBuffer::getMemBufferCopy(blob, key)};
+        }
+
+        if (directory.empty() || llvm::sys::fs::create_directories(directory)) {
+            return;
+        }
+
+        llvm::SmallString<256> path(directory);
+        llvm::sys::path::append(path, key + ".dmpc");
+        llvm::SmallString<256> tmp;
+        int fd;
+        if (llvm::sys::fs::createUniqueFile(llvm::Twine(path) + "-%%%%%%%%.tmp", fd, tmp)) {
+            return;
+        }
+        {
+            llvm::raw_fd_ostream os(fd, true);
+            os << blob;
+            os.close();
+            if (os.has_error()) {
+                os.clear_error();
+                llvm::sys::fs::remove(tmp);
+                return;
+            }
+        }
+        if (llvm::sys::fs::rename(tmp, path)) {
+            llvm::sys::fs::remove(tmp);
+        }
+    }
+
+}
@@ -8,10 +8,13 @@ namespace dmp {
         scanner(nullptr)
     {
         if (mgr != nullptr && mgr->getFileName(idx) != "") {
-            file.open(mgr->getFileName(idx), std::ifstream::in);
+            auto contents = llvm::MemoryBuffer::getFile(mgr->getFilePath(idx));
+            if (contents) {
+                buffer = std::move(*contents);
+            }
         }
         if (isOpen()) {
-            scanner = new Lexer(file);
+            scanner = new Lexer(buffer->getBuffer());
         }
     }
 
@@ -22,7 +25,7 @@ namespace dmp {
     }
 
     bool InputFile::isOpen() const {
-        return file.is_open();
+        return buffer != nullptr;
     }
 
     std::string InputFile::filename() const {
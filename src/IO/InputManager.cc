@@ -1,3 +1,5 @@
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/Path.h>
 #include <IO/InputManager.h>
 #include <IO/InputFile.h>
 
@@ -46,6 +48,17 @@ namespace dmp {
         return "";
     }
 
+    /* Relative file names are looked up in the working directory of the compilation, if one is set */
+    std::string InputManager::getFilePath(uint16_t idx) const {
+        auto name = getFileName(idx);
+        if (directory.empty() || name.empty() || !llvm::sys::path::is_relative(name)) {
+            return name;
+        }
+        llvm::SmallString<256> path(directory);
+        llvm::sys::path::append(path, name);
+        return std::string(path.str());
+    }
+
     bool InputManager::set(const std::string& filename) {
         if (isActive(filename) || isProcessed(filename)) {
             return false;
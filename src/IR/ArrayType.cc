@@ -16,21 +16,7 @@ namespace dmp {
     {
         llvm_type = llvm::ArrayType::get(ao->llvm_type, n);
         complete = true;
-    }
-
-    bool ArrayType::operator==(const Type& t) const {
-        if (is != t.is) return false;
-        for (auto bc : being_compared) {
-            if (bc.first == this && bc.second == &t) {
-                return true;
-            }
-        }
-
-        being_compared.push_back(std::pair<const Type*, const Type*>(this, &t));
-        auto at = static_cast<const ArrayType*>(&t);
-        bool retval = (nelements == at->nelements) && (*array_of == *at->array_of);
-        being_compared.pop_back();
-        return retval;
+        canon = TheTypeContext->unique({TYPE_ARRAY, TypeContext::component(ao), n});
     }
 
     bool ArrayType::construct(const std::shared_ptr<Type>& t) {
@@ -42,6 +28,9 @@ namespace dmp {
         nelements = at->nelements;
         llvm::cast<llvm::StructType>(llvm_type)->setBody(at->llvm_type, true);
         complete = true;
+        if (!recursive) {
+            canon = t->canon;
+        }
         return true;
     }
  
@@ -51,6 +40,7 @@ namespace dmp {
         at->name = name;
         at->llvm_type = llvm_type;
         at->complete = complete;
+        at->canon = canon;
         return at;
     }
 
@@ -92,7 +82,7 @@ namespace dmp {
         }
 
         t->llvm_type = llvm::StructType::get(*TheContext, tv, true);
-        return std::make_shared<Value>(t, llvm::ConstantStruct::get(llvm::cast<llvm::StructType>(t->llvm_type), cv));
+        return makePooled<Value>(t, llvm::ConstantStruct::get(llvm::cast<llvm::StructType>(t->llvm_type), cv));
     }
 }
 
@@ -1,6 +1,7 @@
 #include <llvm/IR/Constants.h>
 #include <Common/Globals.h>
 #include <IR/BinaryOp.h>
+#include <IR/ConstFold.h>
 #include <IR/UnaryOp.h>
 #include <IR/MemoryOp.h>
 #include <IR/PrimitiveType.h>
@@ -17,11 +18,15 @@ namespace dmp {
         if (*le->type != *re->type) {
             return ret;
         }
+        auto lit = ConstFold::binary(BINARYOP_ADD, le, re);
+        if (lit) {
+            return lit;
+        }
         if (le->type->isInt()) {
-            return std::make_shared<Value>(le->type, TheBuilder->CreateAdd(le->val(), re->val()));
+            return makePooled<Value>(le->type, TheBuilder->CreateAdd(le->val(), re->val()));
         }
         else if (le->type->isReal()) {
-            return std::make_shared<Value>(le->type, TheBuilder->CreateFAdd(le->val(), re->val()));
+            return makePooled<Value>(le->type, TheBuilder->CreateFAdd(le->val(), re->val()));
         }
         return ret;
     }
@@ -31,11 +36,15 @@ namespace dmp {
         if (*le->type != *re->type) {
             return ret;
         }
+        auto lit = ConstFold::binary(BINARYOP_SUBTRACT, le, re);
+        if (lit) {
+            return lit;
+        }
         if (le->type->isInt()) {
-            return std::make_shared<Value>(le->type, TheBuilder->CreateSub(le->val(), re->val()));
+            return makePooled<Value>(le->type, TheBuilder->CreateSub(le->val(), re->val()));
         }
         else if (le->type->isReal()) {
-            return std::make_shared<Value>(le->type, TheBuilder->CreateFSub(le->val(), re->val()));
+            return makePooled<Value>(le->type, TheBuilder->CreateFSub(le->val(), re->val()));
         }
         return ret;
     }
@@ -45,11 +54,15 @@ namespace dmp {
         if (*le->type != *re->type) {
             return ret;
         }
+        auto lit = ConstFold::binary(BINARYOP_MULTIPLY, le, re);
+        if (lit) {
+            return lit;
+        }
         if (le->type->isInt()) {
-            return std::make_shared<Value>(le->type, TheBuilder->CreateMul(le->val(), re->val()));
+            return makePooled<Value>(le->type, TheBuilder->CreateMul(le->val(), re->val()));
         }
         else if (le->type->isReal()) {
-            return std::make_shared<Value>(le->type, TheBuilder->CreateFMul(le->val(), re->val()));
+            return makePooled<Value>(le->type, TheBuilder->CreateFMul(le->val(), re->val()));
         }
         return ret;
     }
@@ -62,16 +75,20 @@ namespace dmp {
         if (checkValidDivision(le, re) != UB_NONE) {
             return ret;
         }
+        auto lit = ConstFold::binary(BINARYOP_DIVIDE, le, re);
+        if (lit) {
+            return lit;
+        }
         if (le->type->isInt()) {
             if (le->type->isUnsignedInt()) {
-                return std::make_shared<Value>(le->type, TheBuilder->CreateUDiv(le->val(), re->val()));
+                return makePooled<Value>(le->type, TheBuilder->CreateUDiv(le->val(), re->val()));
             }
             else {
-                return std::make_shared<Value>(le->type, TheBuilder->CreateSDiv(le->val(), re->val()));
+                return makePooled<Value>(le->type, TheBuilder->CreateSDiv(le->val(), re->val()));
             }
         }
         else if (le->type->isReal()) {
-            return std::make_shared<Value>(le->type, TheBuilder->CreateFDiv(le->val(), re->val()));
+            return makePooled<Value>(le->type, TheBuilder->CreateFDiv(le->val(), re->val()));
         }
         return ret;
     }
@@ -84,16 +101,20 @@ namespace dmp {
         if (checkValidDivision(le, re) != UB_NONE) {
             return ret;
         }
+        auto lit = ConstFold::binary(BINARYOP_REMAINDER, le, re);
+        if (lit) {
+            return lit;
+        }
         if (le->type->isInt()) {
             if (le->type->isUnsignedInt()) {
-                return std::make_shared<Value>(le->type, TheBuilder->CreateURem(le->val(), re->val()));
+                return makePooled<Value>(le->type, TheBuilder->CreateURem(le->val(), re->val()));
             }
             else {
-                return std::make_shared<Value>(le->type, TheBuilder->CreateSRem(le->val(), re->val()));
+                return makePooled<Value>(le->type, TheBuilder->CreateSRem(le->val(), re->val()));
             }
         }
         else if (le->type->isReal()) {
-            return std::make_shared<Value>(le->type, TheBuilder->CreateFRem(le->val(), re->val()));
+            return makePooled<Value>(le->type, TheBuilder->CreateFRem(le->val(), re->val()));
         }
         return ret;
     }
@@ -103,20 +124,24 @@ namespace dmp {
         if (*le->type != *re->type) {
             return ret;
         }
-        auto ty = std::make_shared<PrimitiveType>(TYPE_BOOL);
+        auto lit = ConstFold::binary(BINARYOP_EQUAL, le, re);
+        if (lit) {
+            return lit;
+        }
+        const auto& ty = TheTypeContext->primitive(TYPE_BOOL);
         if (le->type->isBool()) {
-            return std::make_shared<Value>(ty, TheBuilder->CreateICmpEQ(le->val(), re->val()));
+            return makePooled<Value>(ty, TheBuilder->CreateICmpEQ(le->val(), re->val()));
         }
         else if (le->type->isInt()) {
-            return std::make_shared<Value>(ty, TheBuilder->CreateICmpEQ(le->val(), re->val()));
+            return makePooled<Value>(ty, TheBuilder->CreateICmpEQ(le->val(), re->val()));
         }
         else if (le->type->isReal()) {
-            return std::make_shared<Value>(ty, TheBuilder->CreateFCmpOEQ(le->val(), re->val()));
+            return makePooled<Value>(ty, TheBuilder->CreateFCmpOEQ(le->val(), re->val()));
         }
         else if (le->type->isPtr()) {
-            auto li = recast(le, std::make_shared<PrimitiveType>(TYPE_UINT64));
-            auto ri = recast(re, std::make_shared<PrimitiveType>(TYPE_UINT64));
-            return std::make_shared<Value>(ty, TheBuilder->CreateICmpEQ(li->val(), ri->val()));
+            auto li = recast(le, TheTypeContext->primitive(TYPE_UINT64));
+            auto ri = recast(re, TheTypeContext->primitive(TYPE_UINT64));
+            return makePooled<Value>(ty, TheBuilder->CreateICmpEQ(li->val(), ri->val()));
         }
         return ret;
     }
@@ -126,20 +151,24 @@ namespace dmp {
         if (*le->type != *re->type) {
             return ret;
         }
-        auto ty = std::make_shared<PrimitiveType>(TYPE_BOOL);
+        auto lit = ConstFold::binary(BINARYOP_NOT_EQUAL, le, re);
+        if (lit) {
+            return lit;
+        }
+        const auto& ty = TheTypeContext->primitive(TYPE_BOOL);
         if (le->type->isBool()) {
-            return std::make_shared<Value>(ty, TheBuilder->CreateICmpNE(le->val(), re->val()));
+            return makePooled<Value>(ty, TheBuilder->CreateICmpNE(le->val(), re->val()));
         }
         else if (le->type->isInt()) {
-            return std::make_shared<Value>(ty, TheBuilder->CreateICmpNE(le->val(), re->val()));
+            return makePooled<Value>(ty, TheBuilder->CreateICmpNE(le->val(), re->val()));
         }
         else if (le->type->isReal()) {
-            return std::make_shared<Value>(ty, TheBuilder->CreateFCmpUNE(le->val(), re->val()));
+            return makePooled<Value>(ty, TheBuilder->CreateFCmpUNE(le->val(), re->val()));
         }
         else if (le->type->isPtr()) {
-            auto li = recast(le, std::make_shared<PrimitiveType>(TYPE_UINT64));
-            auto ri = recast(re, std::make_shared<PrimitiveType>(TYPE_UINT64));
-            return std::make_shared<Value>(ty, TheBuilder->CreateICmpNE(li->val(), ri->val()));
+            auto li = recast(le, TheTypeContext->primitive(TYPE_UINT64));
+            auto ri = recast(re, TheTypeContext->primitive(TYPE_UINT64));
+            return makePooled<Value>(ty, TheBuilder->CreateICmpNE(li->val(), ri->val()));
         }
         return ret;
     }
@@ -149,20 +178,24 @@ namespace dmp {
         if (*le->type != *re->type) {
             return ret;
         }
-        auto ty = std::make_shared<PrimitiveType>(TYPE_BOOL);
+        auto lit = ConstFold::binary(BINARYOP_GREATER, le, re);
+        if (lit) {
+            return lit;
+        }
+        const auto& ty = TheTypeContext->primitive(TYPE_BOOL);
         if (le->type->isUnsignedInt()) {
-            return std::make_shared<Value>(ty, TheBuilder->CreateICmpUGT(le->val(), re->val()));
+            return makePooled<Value>(ty, TheBuilder->CreateICmpUGT(le->val(), re->val()));
         }
         else if (le->type->isSignedInt()) {
-            return std::make_shared<Value>(ty, TheBuilder->CreateICmpSGT(le->val(), re->val()));
+            return makePooled<Value>(ty, TheBuilder->CreateICmpSGT(le->val(), re->val()));
         }
         else if (le->type->isReal()) {
-            return std::make_shared<Value>(ty, TheBuilder->CreateFCmpOGT(le->val(), re->val()));
+            return makePooled<Value>(ty, TheBuilder->CreateFCmpOGT(le->val(), re->val()));
         }
         else if (le->type->isPtr()) {
-            auto li = recast(le, std::make_shared<PrimitiveType>(TYPE_UINT64));
-            auto ri = recast(re, std::make_shared<PrimitiveType>(TYPE_UINT64));
-            return std::make_shared<Value>(ty, TheBuilder->CreateICmpUGT(li->val(), ri->val()));
+            auto li = recast(le, TheTypeContext->primitive(TYPE_UINT64));
+            auto ri = recast(re, TheTypeContext->primitive(TYPE_UINT64));
+            return makePooled<Value>(ty, TheBuilder->CreateICmpUGT(li->val(), ri->val()));
         }
         return ret;
     }
@@ -172,20 +205,24 @@ namespace dmp {
         if (*le->type != *re->type) {
             return ret;
         }
-        auto ty = std::make_shared<PrimitiveType>(TYPE_BOOL);
+        auto lit = ConstFold::binary(BINARYOP_LESSER, le, re);
+        if (lit) {
+            return lit;
+        }
+        const auto& ty = TheTypeContext->primitive(TYPE_BOOL);
         if (le->type->isUnsignedInt()) {
-            return std::make_shared<Value>(ty, TheBuilder->CreateICmpULT(le->val(), re->val()));
+            return makePooled<Value>(ty, TheBuilder->CreateICmpULT(le->val(), re->val()));
         }
         else if (le->type->isSignedInt()) {
-            return std::make_shared<Value>(ty, TheBuilder->CreateICmpSLT(le->val(), re->val()));
+            return makePooled<Value>(ty, TheBuilder->CreateICmpSLT(le->val(), re->val()));
         }
         else if (le->type->isReal()) {
-            return std::make_shared<Value>(ty, TheBuilder->CreateFCmpOLT(le->val(), re->val()));
+            return makePooled<Value>(ty, TheBuilder->CreateFCmpOLT(le->val(), re->val()));
         }
         else if (le->type->isPtr()) {
-            auto li = recast(le, std::make_shared<PrimitiveType>(TYPE_UINT64));
-            auto ri = recast(re, std::make_shared<PrimitiveType>(TYPE_UINT64));
-            return std::make_shared<Value>(ty, TheBuilder->CreateICmpULT(li->val(), ri->val()));
+            auto li = recast(le, TheTypeContext->primitive(TYPE_UINT64));
+            auto ri = recast(re, TheTypeContext->primitive(TYPE_UINT64));
+            return makePooled<Value>(ty, TheBuilder->CreateICmpULT(li->val(), ri->val()));
         }
         return ret;
     }
@@ -195,20 +232,24 @@ namespace dmp {
         if (*le->type != *re->type) {
             return ret;
         }
-        auto ty = std::make_shared<PrimitiveType>(TYPE_BOOL);
+        auto lit = ConstFold::binary(BINARYOP_GREATER_EQUAL, le, re);
+        if (lit) {
+            return lit;
+        }
+        const auto& ty = TheTypeContext->primitive(TYPE_BOOL);
         if (le->type->isUnsignedInt()) {
-            return std::make_shared<Value>(ty, TheBuilder->CreateICmpUGE(le->val(), re->val()));
+            return makePooled<Value>(ty, TheBuilder->CreateICmpUGE(le->val(), re->val()));
         }
         else if (le->type->isSignedInt()) {
-            return std::make_shared<Value>(ty, TheBuilder->CreateICmpSGE(le->val(), re->val()));
+            return makePooled<Value>(ty, TheBuilder->CreateICmpSGE(le->val(), re->val()));
         }
         else if (le->type->isReal()) {
-            return std::make_shared<Value>(ty, TheBuilder->CreateFCmpOGE(le->val(), re->val()));
+            return makePooled<Value>(ty, TheBuilder->CreateFCmpOGE(le->val(), re->val()));
         }
         else if (le->type->isPtr()) {
-            auto li = recast(le, std::make_shared<PrimitiveType>(TYPE_UINT64));
-            auto ri = recast(re, std::make_shared<PrimitiveType>(TYPE_UINT64));
-            return std::make_shared<Value>(ty, TheBuilder->CreateICmpUGE(li->val(), ri->val()));
+            auto li = recast(le, TheTypeContext->primitive(TYPE_UINT64));
+            auto ri = recast(re, TheTypeContext->primitive(TYPE_UINT64));
+            return makePooled<Value>(ty, TheBuilder->CreateICmpUGE(li->val(), ri->val()));
         }
         return ret;
     }
@@ -218,20 +259,24 @@ namespace dmp {
         if (*le->type != *re->type) {
             return ret;
         }
-        auto ty = std::make_shared<PrimitiveType>(TYPE_BOOL);
+        auto lit = ConstFold::binary(BINARYOP_LESSER_EQUAL, le, re);
+        if (lit) {
+            return lit;
+        }
+        const auto& ty = TheTypeContext->primitive(TYPE_BOOL);
         if (le->type->isUnsignedInt()) {
-            return std::make_shared<Value>(ty, TheBuilder->CreateICmpULE(le->val(), re->val()));
+            return makePooled<Value>(ty, TheBuilder->CreateICmpULE(le->val(), re->val()));
         }
         else if (le->type->isSignedInt()) {
-            return std::make_shared<Value>(ty, TheBuilder->CreateICmpSLE(le->val(), re->val()));
+            return makePooled<Value>(ty, TheBuilder->CreateICmpSLE(le->val(), re->val()));
         }
         else if (le->type->isReal()) {
-            return std::make_shared<Value>(ty, TheBuilder->CreateFCmpOLE(le->val(), re->val()));
+            return makePooled<Value>(ty, TheBuilder->CreateFCmpOLE(le->val(), re->val()));
         }
         else if (le->type->isPtr()) {
-            auto li = recast(le, std::make_shared<PrimitiveType>(TYPE_UINT64));
-            auto ri = recast(re, std::make_shared<PrimitiveType>(TYPE_UINT64));
-            return std::make_shared<Value>(ty, TheBuilder->CreateICmpULE(li->val(), ri->val()));
+            auto li = recast(le, TheTypeContext->primitive(TYPE_UINT64));
+            auto ri = recast(re, TheTypeContext->primitive(TYPE_UINT64));
+            return makePooled<Value>(ty, TheBuilder->CreateICmpULE(li->val(), ri->val()));
         }
         return ret;
     }
@@ -241,8 +286,12 @@ namespace dmp {
         if (*le->type != *re->type) {
             return ret;
         }
+        auto lit = ConstFold::binary(BINARYOP_SHIFT_LEFT, le, re);
+        if (lit) {
+            return lit;
+        }
         if (le->type->isInt()) {
-            return std::make_shared<Value>(le->type, TheBuilder->CreateShl(le->val(), re->val()));
+            return makePooled<Value>(le->type, TheBuilder->CreateShl(le->val(), re->val()));
         }
         return ret;
     }
@@ -252,8 +301,12 @@ namespace dmp {
         if (*le->type != *re->type) {
             return ret;
         }
+        auto lit = ConstFold::binary(BINARYOP_SHIFT_RIGHT, le, re);
+        if (lit) {
+            return lit;
+        }
         if (le->type->isInt()) {
-            return std::make_shared<Value>(le->type, TheBuilder->CreateLShr(le->val(), re->val()));
+            return makePooled<Value>(le->type, TheBuilder->CreateLShr(le->val(), re->val()));
         }
         return ret;
     }
@@ -263,8 +316,12 @@ namespace dmp {
         if (*le->type != *re->type) {
             return ret;
         }
+        auto lit = ConstFold::binary(BINARYOP_BIT_AND, le, re);
+        if (lit) {
+            return lit;
+        }
         if (le->type->isInt()) {
-            return std::make_shared<Value>(le->type, TheBuilder->CreateAnd(le->val(), re->val()));
+            return makePooled<Value>(le->type, TheBuilder->CreateAnd(le->val(), re->val()));
         }
         return ret;
     }
@@ -274,8 +331,12 @@ namespace dmp {
         if (*le->type != *re->type) {
             return ret;
         }
+        auto lit = ConstFold::binary(BINARYOP_BIT_XOR, le, re);
+        if (lit) {
+            return lit;
+        }
         if (le->type->isInt()) {
-            return std::make_shared<Value>(le->type, TheBuilder->CreateXor(le->val(), re->val()));
+            return makePooled<Value>(le->type, TheBuilder->CreateXor(le->val(), re->val()));
         }
         return ret;
     }
@@ -285,8 +346,12 @@ namespace dmp {
         if (*le->type != *re->type) {
             return ret;
         }
+        auto lit = ConstFold::binary(BINARYOP_BIT_OR, le, re);
+        if (lit) {
+            return lit;
+        }
         if (le->type->isInt()) {
-            return std::make_shared<Value>(le->type, TheBuilder->CreateOr(le->val(), re->val()));
+            return makePooled<Value>(le->type, TheBuilder->CreateOr(le->val(), re->val()));
         }
         return ret;
     }
@@ -296,7 +361,11 @@ namespace dmp {
         if (!le->type->isBool() || !re->type->isBool()) {
             return ret;
         }
-        return std::make_shared<Value>(le->type, TheBuilder->CreateAnd(le->val(), re->val()));
+        auto lit = ConstFold::binary(BINARYOP_LOGICAL_AND, le, re);
+        if (lit) {
+            return lit;
+        }
+        return makePooled<Value>(le->type, TheBuilder->CreateAnd(le->val(), re->val()));
     }
 
     std::shared_ptr<Value> BinaryOp::logOr(const std::shared_ptr<Value>& le, const std::shared_ptr<Value>& re) {
@@ -304,7 +373,11 @@ namespace dmp {
         if (!le->type->isBool() || !re->type->isBool()) {
             return ret;
         }
-        return std::make_shared<Value>(le->type, TheBuilder->CreateOr(le->val(), re->val()));
+        auto lit = ConstFold::binary(BINARYOP_LOGICAL_OR, le, re);
+        if (lit) {
+            return lit;
+        }
+        return makePooled<Value>(le->type, TheBuilder->CreateOr(le->val(), re->val()));
     }
 
     std::shared_ptr<Value> BinaryOp::element(const std::shared_ptr<Variable>& var, const std::shared_ptr<Value>& i) {
@@ -326,7 +399,7 @@ namespace dmp {
                     return ret;
                 }
                 auto gep = TheBuilder->CreateStructGEP(var->type->llvm_type, var->ptr(), idx);
-                auto v = std::make_shared<Variable>(STORAGE_REFERENCE, "", st->members[idx].type);
+                auto v = makePooled<Variable>(STORAGE_REFERENCE, "", st->members[idx].type);
                 v->llvm_value = TheBuilder->CreateBitCast(gep, llvm::PointerType::get(v->type->llvm_type, 0));
                 ret = v;
             }
@@ -335,9 +408,9 @@ namespace dmp {
                 if (idx >= ut->members.size()) {
                     return ret;
                 }
-                auto t = std::make_shared<PointerType>(ut->members[idx].type);
-                auto v = std::make_shared<Variable>(STORAGE_REFERENCE, "", t->points_to);
-                v->llvm_value = TheBuilder->CreateBitCast(var->ptr(), t->llvm_type);
+                const auto& mt = ut->members[idx].type;
+                auto v = makePooled<Variable>(STORAGE_REFERENCE, "", mt);
+                v->llvm_value = TheBuilder->CreateBitCast(var->ptr(), llvm::PointerType::get(mt->llvm_type, 0));
                 ret = v;
             }
         }
@@ -353,14 +426,14 @@ namespace dmp {
                 }
                 vidx.push_back(i->val());
                 auto gep = TheBuilder->CreateInBoundsGEP(var->type->llvm_type, var->ptr(), vidx);
-                auto v = std::make_shared<Variable>(STORAGE_REFERENCE, "", at->array_of);
+                auto v = makePooled<Variable>(STORAGE_REFERENCE, "", at->array_of);
                 v->llvm_value = TheBuilder->CreateBitCast(gep, llvm::PointerType::get(v->type->llvm_type, 0));
                 ret = v;
             }
             else if (var->type->isPtr()) {
                 auto pt = static_cast<PointerType*>(var->type.get());
                 auto gep = TheBuilder->CreateInBoundsGEP(pt->points_to->llvm_type, var->val(), i->val());
-                auto v = std::make_shared<Variable>(STORAGE_REFERENCE, "", pt->points_to);
+                auto v = makePooled<Variable>(STORAGE_REFERENCE, "", pt->points_to);
                 v->llvm_value = TheBuilder->CreateBitCast(gep, llvm::PointerType::get(v->type->llvm_type, 0));
                 ret = v;
             }
@@ -369,7 +442,7 @@ namespace dmp {
         return ret;
     }
 
-    std::shared_ptr<Value> BinaryOp::member(const std::shared_ptr<Variable>& var, const std::string& name) {
+    std::shared_ptr<Value> BinaryOp::member(const std::shared_ptr<Variable>& var, uint32_t id) {
         std::shared_ptr<Value> ret;
 
         if (!var->type->isStruct() && !var->type->isUnion()) {
@@ -381,7 +454,7 @@ namespace dmp {
             bool found = false;
             std::size_t idx = 0;
             for (std::size_t i = 0; i < st->members.size(); i++) {
-                if (st->members[i].name->name == name) {
+                if (st->members[i].name->id == id) {
                     idx = i;
                     found = true;
                     break;
@@ -391,7 +464,7 @@ namespace dmp {
                 return ret;
             }
             auto gep = TheBuilder->CreateStructGEP(var->type->llvm_type, var->ptr(), idx);
-            auto v = std::make_shared<Variable>(STORAGE_REFERENCE, "", st->members[idx].type);
+            auto v = makePooled<Variable>(STORAGE_REFERENCE, "", st->members[idx].type);
             v->llvm_value = TheBuilder->CreateBitCast(gep, llvm::PointerType::get(v->type->llvm_type, 0));
             ret = v;
         }
@@ -400,7 +473,7 @@ namespace dmp {
             bool found = false;
             std::size_t idx = 0; 
             for (std::size_t i = 0; i < ut->members.size(); i++) {
-                if (ut->members[i].name->name == name) {
+                if (ut->members[i].name->id == id) {
                     idx = i;
                     found = true;
                     break;
@@ -409,9 +482,9 @@ namespace dmp {
             if (!found) {
                 return ret;
             }
-            auto t = std::make_shared<PointerType>(ut->members[idx].type);
-            auto v = std::make_shared<Variable>(STORAGE_REFERENCE, "", t->points_to);
-            v->llvm_value = TheBuilder->CreateBitCast(var->ptr(), t->llvm_type);
+            const auto& mt = ut->members[idx].type;
+            auto v = makePooled<Variable>(STORAGE_REFERENCE, "", mt);
+            v->llvm_value = TheBuilder->CreateBitCast(var->ptr(), llvm::PointerType::get(mt->llvm_type, 0));
             ret = v;
         }
 
@@ -421,13 +494,10 @@ namespace dmp {
     std::shared_ptr<Value> BinaryOp::recast(const std::shared_ptr<Value>& e, const std::shared_ptr<Type>& ty) {
         
         std::shared_ptr<Value> ret;
-        auto t = ty->clone();
-        if (t->isPtr()) {
-            t->llvm_type = llvm::PointerType::get(static_cast<PointerType*>(t.get())->points_to->llvm_type, 0); 
-        }
+        auto t = PointerType::directType(ty);
 
         if (*e->type == *t) {
-            return std::make_shared<Value>(e->type, e->val());
+            return makePooled<Value>(e->type, e->val());
         }
 
         llvm::Value* v;
@@ -513,7 +583,7 @@ namespace dmp {
         }
 
         if (v != nullptr) {
-            ret = std::make_shared<Value>(t, v);
+            ret = makePooled<Value>(t, v);
         }
         return ret;
     }
@@ -0,0 +1,189 @@
+#include <cstdint>
+#include <llvm/ADT/APFloat.h>
+#include <IR/ConstFold.h>
+#include <AST/ExprNode.h>
+
+namespace dmp {
+
+    static bool isFoldableInt(const std::shared_ptr<Value>& v) {
+        return v->isLiteralInt() || v->isLiteralChar();
+    }
+
+    static int64_t intValue(const std::shared_ptr<Value>& v) {
+        if (v->isLiteralChar()) {
+            return static_cast<int8_t>(static_cast<CharLiteral*>(v.get())->literal);
+        }
+        return static_cast<IntLiteral*>(v.get())->literal;
+    }
+
+    static std::shared_ptr<Value> intResult(const std::shared_ptr<Value>& like, uint64_t i) {
+        if (like->isLiteralChar()) {
+            return makePooled<CharLiteral>(static_cast<char>(i));
+        }
+        return makePooled<IntLiteral>(i);
+    }
+
+    static std::shared_ptr<Value> foldInt(uint16_t op, const std::shared_ptr<Value>& le, const std::shared_ptr<Value>& re) {
+
+        std::shared_ptr<Value> ret;
+
+        std::size_t bits = le->isLiteralChar() ? 8 : 64;
+        int64_t smin = le->isLiteralChar() ? INT8_MIN : INT64_MIN;
+        int64_t sl = intValue(le);
+        int64_t sr = intValue(re);
+        uint64_t ul = static_cast<uint64_t>(sl);
+        uint64_t ur = static_cast<uint64_t>(sr);
+
+        switch (op) {
+            case BINARYOP_ADD           : return intResult(le, ul + ur);
+            case BINARYOP_SUBTRACT      : return intResult(le, ul - ur);
+            case BINARYOP_MULTIPLY      : return intResult(le, ul * ur);
+            case BINARYOP_BIT_AND       : return intResult(le, ul & ur);
+            case BINARYOP_BIT_OR        : return intResult(le, ul | ur);
+            case BINARYOP_BIT_XOR       : return intResult(le, ul ^ ur);
+            case BINARYOP_EQUAL         : return makePooled<BoolLiteral>(sl == sr);
+            case BINARYOP_NOT_EQUAL     : return makePooled<BoolLiteral>(sl != sr);
+            case BINARYOP_GREATER       : return makePooled<BoolLiteral>(sl >  sr);
+            case BINARYOP_LESSER        : return makePooled<BoolLiteral>(sl <  sr);
+            case BINARYOP_GREATER_EQUAL : return makePooled<BoolLiteral>(sl >= sr);
+            case BINARYOP_LESSER_EQUAL  : return makePooled<BoolLiteral>(sl <= sr);
+            default                     : break;
+        }
+
+        if (op == BINARYOP_DIVIDE || op == BINARYOP_REMAINDER) {
+            if (sr == 0 || (sl == smin && sr == -1)) {
+                return ret;
+            }
+            return intResult(le, static_cast<uint64_t>(op == BINARYOP_DIVIDE ? sl / sr : sl % sr));
+        }
+
+        /* Shifting by the bit width or more yields poison in LLVM; leave such shifts to the IRBuilder */
+        if (op == BINARYOP_SHIFT_LEFT || op == BINARYOP_SHIFT_RIGHT) {
+            if (ur >= bits) {
+                return ret;
+            }
+            if (op == BINARYOP_SHIFT_LEFT) {
+                return intResult(le, ul << ur);
+            }
+            if (bits == 8) {
+                ul = static_cast<uint8_t>(ul);
+            }
+            return intResult(le, ul >> ur);
+        }
+
+        return ret;
+    }
+
+    static std::shared_ptr<Value> realResult(llvm::APFloat d) {
+        return makePooled<RealLiteral>(d.convertToDouble());
+    }
+
+    /*
+    Real arithmetic is done with APFloat rather than with host doubles, so that the result (including the sign and
+    payload of a NaN) is bit-for-bit what the LLVM constant folder would have produced.
+    */
+    static std::shared_ptr<Value> foldReal(uint16_t op, const std::shared_ptr<Value>& le, const std::shared_ptr<Value>& re) {
+
+        std::shared_ptr<Value> ret;
+
+        llvm::APFloat l(static_cast<RealLiteral*>(le.get())->literal);
+        llvm::APFloat r(static_cast<RealLiteral*>(re.get())->literal);
+        auto rm = llvm::APFloat::rmNearestTiesToEven;
+        auto cmp = l.compare(r);
+
+        switch (op) {
+            case BINARYOP_ADD           : l.add(r, rm);      return realResult(l);
+            case BINARYOP_SUBTRACT      : l.subtract(r, rm); return realResult(l);
+            case BINARYOP_MULTIPLY      : l.multiply(r, rm); return realResult(l);
+            case BINARYOP_EQUAL         : return makePooled<BoolLiteral>(cmp == llvm::APFloat::cmpEqual);
+            case BINARYOP_NOT_EQUAL     : return makePooled<BoolLiteral>(cmp != llvm::APFloat::cmpEqual);
+            case BINARYOP_GREATER       : return makePooled<BoolLiteral>(cmp == llvm::APFloat::cmpGreaterThan);
+            case BINARYOP_LESSER        : return makePooled<BoolLiteral>(cmp == llvm::APFloat::cmpLessThan);
+            case BINARYOP_GREATER_EQUAL : return makePooled<BoolLiteral>(cmp == llvm::APFloat::cmpGreaterThan || cmp == llvm::APFloat::cmpEqual);
+            case BINARYOP_LESSER_EQUAL  : return makePooled<BoolLiteral>(cmp == llvm::APFloat::cmpLessThan || cmp == llvm::APFloat::cmpEqual);
+            default                     : break;
+        }
+
+        if (!r.isZero()) {
+            if (op == BINARYOP_DIVIDE) {
+                l.divide(r, rm);
+                return realResult(l);
+            }
+            if (op == BINARYOP_REMAINDER) {
+                l.mod(r);
+                return realResult(l);
+            }
+        }
+
+        return ret;
+    }
+
+    static std::shared_ptr<Value> foldBool(uint16_t op, const std::shared_ptr<Value>& le, const std::shared_ptr<Value>& re) {
+
+        std::shared_ptr<Value> ret;
+
+        bool l = static_cast<BoolLiteral*>(le.get())->literal;
+        bool r = static_cast<BoolLiteral*>(re.get())->literal;
+
+        switch (op) {
+            case BINARYOP_EQUAL         : return makePooled<BoolLiteral>(l == r);
+            case BINARYOP_NOT_EQUAL     : return makePooled<BoolLiteral>(l != r);
+            case BINARYOP_LOGICAL_AND   : return makePooled<BoolLiteral>(l && r);
+            case BINARYOP_LOGICAL_OR    : return makePooled<BoolLiteral>(l || r);
+            default                     : break;
+        }
+
+        return ret;
+    }
+
+    std::shared_ptr<Value> ConstFold::binary(uint16_t op, const std::shared_ptr<Value>& le, const std::shared_ptr<Value>& re) {
+
+        std::shared_ptr<Value> ret;
+
+        if (le->is != re->is) {
+            return ret;
+        }
+        if (isFoldableInt(le)) {
+            return foldInt(op, le, re);
+        }
+        if (le->isLiteralReal()) {
+            return foldReal(op, le, re);
+        }
+        if (le->isLiteralBool()) {
+            return foldBool(op, le, re);
+        }
+
+        return ret;
+    }
+
+    std::shared_ptr<Value> ConstFold::unary(uint16_t op, const std::shared_ptr<Value>& e) {
+
+        std::shared_ptr<Value> ret;
+
+        if (isFoldableInt(e)) {
+            uint64_t i = static_cast<uint64_t>(intValue(e));
+            if (op == UNARYOP_NEGATE) {
+                return intResult(e, 0 - i);
+            }
+            if (op == UNARYOP_COMPLEMENT) {
+                return intResult(e, ~i);
+            }
+        }
+        else if (e->isLiteralReal()) {
+            /* Negation is emitted as 0.0 - x (so -0.0 becomes +0.0) */
+            if (op == UNARYOP_NEGATE) {
+                llvm::APFloat d(0.0);
+                d.subtract(llvm::APFloat(static_cast<RealLiteral*>(e.get())->literal), llvm::APFloat::rmNearestTiesToEven);
+                return realResult(d);
+            }
+        }
+        else if (e->isLiteralBool()) {
+            if (op == UNARYOP_NOT) {
+                return makePooled<BoolLiteral>(!static_cast<BoolLiteral*>(e.get())->literal);
+            }
+        }
+
+        return ret;
+    }
+
+}
@@ -1,4 +1,6 @@
 #include <llvm/IR/CFG.h>
+#include <llvm/IR/Dominators.h>
+#include <llvm/Transforms/Utils/PromoteMemToReg.h>
 #include <Common/Globals.h>
 #include <IR/Function.h>
 #include <IR/FunctionType.h>
@@ -56,7 +58,7 @@ namespace dmp {
         CodeBlock::insert(start_block);    
 
         if (!ft->ret->retDirectly()) {
-            retvar = std::make_shared<Variable>(STORAGE_LOCAL, "", ft->ret);
+            retvar = makePooled<Variable>(STORAGE_LOCAL, "", ft->ret);
             retvar->llvm_value = fn->getArg(0);
             retblock = std::make_shared<CodeBlock>();
         }
@@ -64,7 +66,7 @@ namespace dmp {
             auto idx = ft->ret->retDirectly() ? i : i+1;
             std::shared_ptr<Variable> var;
             if (!ft->args[i].passByRef() && ft->args[i].type->passDirectly()) {
-                var = std::make_shared<Variable>(STORAGE_LOCAL, "", ft->args[i].type);
+                var = makePooled<Variable>(STORAGE_LOCAL, "", ft->args[i].type);
                 var->declare();
                 if (var->type->isCompound()) {
                     auto u64 = TheBuilder->CreateBitCast(var->ptr(), TheBuilder->getInt64Ty());
@@ -75,18 +77,20 @@ namespace dmp {
                 }
             }
             else {
-                var = std::make_shared<Variable>(STORAGE_REFERENCE, "", ft->args[i].type);
+                var = makePooled<Variable>(STORAGE_REFERENCE, "", ft->args[i].type);
                 var->llvm_value = fn->getArg(idx);
             }
             args.push_back(var);
-            lst->variables[ft->args[i].name->name] = var;
+            lst->bind(ft->args[i].name->id, var);
         }
     }
 
+    void Function::enscope() {
+        lst->enscope();
+    }
+
     void Function::descope() {
-        if (lst->prev) {
-            lst = lst->prev;
-        }
+        lst->descope();
     }
 
     void Function::freeze() {
@@ -219,4 +223,29 @@ namespace dmp {
         }
     }
 
+    /*
+    Rewrite the stack slots of scalar locals into SSA registers (phi nodes where control flow merges).
+    Only slots that are accessed exclusively through plain loads and stores are promoted; a local whose address
+    is taken (e.g. through '@', a reference or pass-by-reference) stays in memory.
+    */
+
+    void Function::promote() {
+
+        auto fn = llvm::cast<llvm::Function>(ptr());
+
+        std::vector<llvm::AllocaInst*> allocas;
+        for (auto& inst : fn->getEntryBlock()) {
+            auto alloca = llvm::dyn_cast<llvm::AllocaInst>(&inst);
+            if (alloca && !alloca->getAllocatedType()->isAggregateType() && llvm::isAllocaPromotable(alloca)) {
+                allocas.push_back(alloca);
+            }
+        }
+        if (allocas.empty()) {
+            return;
+        }
+
+        llvm::DominatorTree dt(*fn);
+        llvm::PromoteMemToReg(allocas, dt);
+    }
+
 }
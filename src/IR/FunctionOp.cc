@@ -2,9 +2,6 @@
 #include <IR/FunctionOp.h>
 #include <IR/BinaryOp.h>
 #include <IR/FunctionType.h>
-#include <IR/PrimitiveType.h>
-#include <IR/CodeBlock.h>
-#include <IR/LST.h>
 #include <AST/Statement.h>
 
 namespace dmp {
@@ -20,7 +17,7 @@ namespace dmp {
 
         std::shared_ptr<Variable> retv;
         if (!ft->ret->retDirectly() || ft->ret->isCompound()) {
-            retv = std::make_shared<Variable>(STORAGE_LOCAL, "", ft->ret);
+            retv = makePooled<Variable>(STORAGE_LOCAL, "", ft->ret);
             retv->declare();
             retv->init();
         }
@@ -57,7 +54,7 @@ namespace dmp {
                 fargs.push_back(args[i]->val());
             }
             else {
-                const auto& v = std::make_shared<Variable>(STORAGE_LOCAL, "", args[i]->type);
+                const auto& v = makePooled<Variable>(STORAGE_LOCAL, "", args[i]->type);
                 v->declare();
                 if (!BinaryOp::assign(v, args[i])) {
                     return ex;
@@ -76,7 +73,7 @@ namespace dmp {
                 lv = TheBuilder->CreateCall(llvm::cast<llvm::FunctionType>(ft->llvm_type), fptr, fargs);
             }
             if (!ft->ret->isCompound()) {
-                ex = std::make_shared<Value>(ft->ret, lv);
+                ex = makePooled<Value>(ft->ret, lv);
             }
             else {
                 auto ptr = TheBuilder->CreateBitCast(retv->ptr(), TheBuilder->getInt64Ty());
@@ -134,27 +131,7 @@ namespace dmp {
         else {
             v = retval->val();
         }
-        if (!func->lst->prev) {
-            if (func->retvar) {
-                TheBuilder->CreateStore(v, func->retvar->ptr());
-                CodeBlock::jump(func->retblock);
-                CodeBlock::insert(func->retblock);
-                TheBuilder->CreateRet(func->retvar->val());
-            }
-            else {
-                TheBuilder->CreateRet(v);
-            }
-        }
-        else {
-            if (!func->retvar) {
-                auto ty = ft->ret->isCompound() ? std::make_shared<PrimitiveType>(TYPE_UINT64) : ft->ret;
-                func->retvar = std::make_shared<Variable>(STORAGE_LOCAL, "", ty);
-                func->retblock = std::make_shared<CodeBlock>();
-                func->retvar->declare();
-            }
-            TheBuilder->CreateStore(v, func->retvar->ptr());
-            CodeBlock::jump(func->retblock);
-        }
+        TheBuilder->CreateRet(v);
         return true;
     }
 
@@ -39,38 +39,14 @@ namespace dmp {
         }
         llvm_type = llvm::FunctionType::get(ret_lt, tv, false);
         complete = true;
-    }
 
-    bool FunctionType::operator==(const Type& t) const {
-        if (t.is != is) return false;
-        for (const auto& bc : being_compared) {
-            if (bc.first == this && bc.second == &t) {
-                return true;
-            }
-        }
-
-        being_compared.push_back(std::pair<const Type*, const Type*>(this, &t));
-        auto ft = static_cast<const FunctionType*>(&t);
-        if (args.size() != ft->args.size()) {
-            being_compared.pop_back();
-            return false;
-        }
-        for (std::size_t i = 0; i < args.size(); i++) {
-            if (*args[i].type != *ft->args[i].type) {
-                being_compared.pop_back();
-                return false;
-            }
-            if (args[i].attr != ft->args[i].attr) {
-                being_compared.pop_back();
-                return false;
-            }
-        }
-        if (*ret != *ft->ret) {
-            being_compared.pop_back();
-            return false;
+        std::vector<uint64_t> key = {TYPE_FUNCTION, args.size()};
+        for (const auto& a : args) {
+            key.push_back(TypeContext::component(a.type));
+            key.push_back(a.attr);
         }
-        being_compared.pop_back();
-        return true;
+        key.push_back(TypeContext::component(ret));
+        canon = TheTypeContext->unique(key);
     }
 
     bool FunctionType::construct(const std::shared_ptr<Type>& t) {
@@ -87,6 +63,7 @@ namespace dmp {
         ft->name = name;
         ft->llvm_type = llvm_type;
         ft->complete = complete;
+        ft->canon = canon;
         return ft;
     }
 }
@@ -5,75 +5,66 @@ namespace dmp {
     LST::LST() {
     }
 
-    LST::LST(const Function& f):
-        prev(f.lst)
-    {
+    void LST::enscope() {
+        scopes.push_back(undo.size());
     }
 
-    bool LST::isDefined(const std::string& n) {
-
-        if (variables.find(n) != variables.end()) {
-            return true;
-        }
-        if (functions.find(n) != functions.end()) {
-            return true;
+    void LST::descope() {
+        if (scopes.empty()) {
+            return;
         }
-        if (!prev) {
-            return false;
+        while (undo.size() > scopes.back()) {
+            bindings[undo.back()].pop_back();
+            undo.pop_back();
         }
-        return prev->isDefined(n);
-
+        scopes.pop_back();
     }
 
-    bool LST::isDefinedInThisScope(const std::string& n) {
+    std::size_t LST::depth() const {
+        return scopes.size();
+    }
 
-        if (variables.find(n) != variables.end()) {
-            return true;
+    void LST::bind(uint32_t id, const std::shared_ptr<Instance>& inst) {
+        auto& stack = bindings[id];
+        if (!stack.empty() && stack.back().scope == depth()) {
+            stack.back().inst = inst;
+            return;
         }
-        if (functions.find(n) != functions.end()) {
-            return true;
-        }
-        return false;
+        stack.push_back({inst, depth()});
+        undo.push_back(id);
+    }
 
+    bool LST::isDefined(uint32_t id) const {
+        return getInstance(id) != nullptr;
     }
 
-    std::shared_ptr<Variable> LST::getVariable(const std::string& n) {
+    bool LST::isDefinedInThisScope(uint32_t id) const {
+        auto it = bindings.find(id);
+        return it != bindings.end() && !it->second.empty() && it->second.back().scope == depth();
+    }
 
-        std::shared_ptr<Variable> var;
-        if (variables.find(n) != variables.end()) {
-            return variables[n];
+    std::shared_ptr<Variable> LST::getVariable(uint32_t id) const {
+        auto inst = getInstance(id);
+        if (!inst || !inst->isVar()) {
+            return std::shared_ptr<Variable>();
         }
-        if (!prev) {
-            return var;
-        }
-        return prev->getVariable(n);
+        return std::static_pointer_cast<Variable>(inst);
     }
 
-    std::shared_ptr<Function> LST::getFunction(const std::string& n) {
-
-        std::shared_ptr<Function> var;
-        if (functions.find(n) != functions.end()) {
-            return functions[n];
-        }
-        if (!prev) {
-            return var;
+    std::shared_ptr<Function> LST::getFunction(uint32_t id) const {
+        auto inst = getInstance(id);
+        if (!inst || !inst->isFunction()) {
+            return std::shared_ptr<Function>();
         }
-        return prev->getFunction(n);
+        return std::static_pointer_cast<Function>(inst);
     }
 
-    std::shared_ptr<Instance> LST::getInstance(const std::string& n) {
-
-        std::shared_ptr<Instance> inst;
-        if (functions.find(n) != functions.end()) {
-            return functions[n];
-        }
-        if (variables.find(n) != variables.end()) {
-            return variables[n];
-        }
-        if (!prev) {
-            return inst;
+    std::shared_ptr<Instance> LST::getInstance(uint32_t id) const {
+        auto it = bindings.find(id);
+        if (it == bindings.end() || it->second.empty()) {
+            return std::shared_ptr<Instance>();
         }
-        return prev->getInstance(n);
+        return it->second.back().inst;
     }
 
 }
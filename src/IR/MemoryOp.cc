@@ -3,14 +3,39 @@
 
 namespace dmp {
 
+    static std::size_t chunkSize(std::size_t remaining) {
+        std::size_t chunk = 8;
+        while (chunk > remaining) {
+            chunk /= 2;
+        }
+        return chunk;
+    }
+
+    static llvm::Value* chunkPtr(llvm::Value* base, std::size_t offset, std::size_t chunk) {
+        auto p = (offset == 0 ? base : TheBuilder->CreateConstInBoundsGEP1_64(TheBuilder->getInt8Ty(), base, offset));
+        return TheBuilder->CreateBitCast(p, llvm::PointerType::get(TheBuilder->getIntNTy(chunk * 8), 0));
+    }
+
     bool MemoryOp::memset(Variable* var, uint8_t v) {
-        TheBuilder->CreateMemSet(var->ptr(), TheBuilder->getInt8(v), var->type->size(), llvm::MaybeAlign(0));
+        auto size = var->type->size();
+        auto align = llvm::Align(var->alignment());
+        if (size > inline_size) {
+            TheBuilder->CreateMemSet(var->ptr(), TheBuilder->getInt8(v), size, align);
+            return true;
+        }
+
+        auto base = TheBuilder->CreateBitCast(var->ptr(), llvm::PointerType::get(TheBuilder->getInt8Ty(), 0));
+        for (std::size_t offset = 0; offset < size; ) {
+            auto chunk = chunkSize(size - offset);
+            auto pattern = llvm::ConstantInt::get(TheBuilder->getIntNTy(chunk * 8), llvm::APInt::getSplat(chunk * 8, llvm::APInt(8, v)));
+            TheBuilder->CreateAlignedStore(pattern, chunkPtr(base, offset, chunk), llvm::commonAlignment(align, offset));
+            offset += chunk;
+        }
         return true;
     }
 
     bool MemoryOp::memset(const std::shared_ptr<Variable>& var, uint8_t v) {
-        TheBuilder->CreateMemSet(var->ptr(), TheBuilder->getInt8(v), var->type->size(), llvm::MaybeAlign(0));
-        return true;
+        return memset(var.get(), v);
     }
 
     bool MemoryOp::memcpy(const std::shared_ptr<Variable>& dest, const std::shared_ptr<Variable>& source) {
@@ -20,7 +45,22 @@ namespace dmp {
             return false;
         }
 
-        TheBuilder->CreateMemCpy(dest->ptr(), llvm::MaybeAlign(0), source->ptr(), llvm::MaybeAlign(0), source->type->size());
+        auto dalign = llvm::Align(dest->alignment());
+        auto salign = llvm::Align(source->alignment());
+        if (sz_src > inline_size) {
+            TheBuilder->CreateMemCpy(dest->ptr(), dalign, source->ptr(), salign, sz_src);
+            return true;
+        }
+
+        auto dbase = TheBuilder->CreateBitCast(dest->ptr(), llvm::PointerType::get(TheBuilder->getInt8Ty(), 0));
+        auto sbase = TheBuilder->CreateBitCast(source->ptr(), llvm::PointerType::get(TheBuilder->getInt8Ty(), 0));
+        for (std::size_t offset = 0; offset < sz_src; ) {
+            auto chunk = chunkSize(sz_src - offset);
+            auto ty = TheBuilder->getIntNTy(chunk * 8);
+            auto val = TheBuilder->CreateAlignedLoad(ty, chunkPtr(sbase, offset, chunk), llvm::commonAlignment(salign, offset));
+            TheBuilder->CreateAlignedStore(val, chunkPtr(dbase, offset, chunk), llvm::commonAlignment(dalign, offset));
+            offset += chunk;
+        }
         return true;
     }
 
@@ -3,30 +3,33 @@
 namespace dmp {
 
     NameType::NameType():
+        name(nullptr),
         attr(0)
     {
     }
     
     NameType::NameType(const std::shared_ptr<Type>& ty):
+        name(nullptr),
         type(ty),
         attr(0)
     {
     }
     
     NameType::NameType(const std::shared_ptr<Type>& ty, uint64_t a):
+        name(nullptr),
         type(ty),
         attr(a)
     {
     }
     
-    NameType::NameType(const std::shared_ptr<Identifier>& nm, const std::shared_ptr<Type>& ty):
+    NameType::NameType(Identifier* nm, const std::shared_ptr<Type>& ty):
         name(nm),
         type(ty),
         attr(0)
     {
     }
 
-    NameType::NameType(const std::shared_ptr<Identifier>& nm, const std::shared_ptr<Type>& ty, uint64_t a):
+    NameType::NameType(Identifier* nm, const std::shared_ptr<Type>& ty, uint64_t a):
         name(nm),
         type(ty),
         attr(a)
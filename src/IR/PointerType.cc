@@ -14,21 +14,7 @@ namespace dmp {
     {
         llvm_type = llvm::PointerType::get(pt->llvm_type, 0);
         complete = true;
-    }
-
-    bool PointerType::operator==(const Type& t) const {
-        if (is != t.is) return false;
-        for (auto bc : being_compared) {
-            if (bc.first == this && bc.second == &t) {
-                return true;
-            }
-        }
-
-        being_compared.push_back(std::pair<const Type*, const Type*>(this, &t));
-        auto pt = static_cast<const PointerType*>(&t);
-        bool retval = (*points_to == *pt->points_to);
-        being_compared.pop_back();
-        return retval;
+        canon = TheTypeContext->unique({TYPE_POINTER, TypeContext::component(pt)});
     }
 
     bool PointerType::construct(const std::shared_ptr<Type>& t) {
@@ -39,6 +25,9 @@ namespace dmp {
         points_to = pt->points_to;
         llvm::cast<llvm::StructType>(llvm_type)->setBody(pt->llvm_type, true);
         complete = true;
+        if (!recursive) {
+            canon = t->canon;
+        }
         return true;
     }
 
@@ -48,8 +37,27 @@ namespace dmp {
         pt->name = name;
         pt->llvm_type = llvm_type;
         pt->complete = complete;
+        pt->canon = canon;
         return pt;
     }
 
+    /*
+    The LLVM type of a named pointer type is an opaque struct wrapping the pointer.
+    Values of such a type carry an equivalent type whose LLVM type is the pointer itself. 
+    It is created once per named type and cached.
+    */
+
+    std::shared_ptr<Type> PointerType::directType(const std::shared_ptr<Type>& t) {
+        if (!t->isPtr() || !llvm::isa<llvm::StructType>(t->llvm_type)) {
+            return t;
+        }
+        auto pt = static_cast<PointerType*>(t.get());
+        if (!pt->direct) {
+            pt->direct = pt->clone();
+            pt->direct->llvm_type = llvm::PointerType::get(pt->points_to->llvm_type, 0);
+        }
+        return pt->direct;
+    }
+
 }
 
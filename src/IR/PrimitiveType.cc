@@ -32,10 +32,6 @@ namespace dmp {
         }
         complete = true;
     }
-
-    bool PrimitiveType::operator==(const Type& t) const {
-        return is == t.is;
-    }
   
     bool PrimitiveType::construct(const std::shared_ptr<Type>&) {
         return false;
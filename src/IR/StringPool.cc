@@ -0,0 +1,22 @@
+#include <llvm/IR/Constants.h>
+#include <Common/Globals.h>
+#include <IR/StringPool.h>
+
+namespace dmp {
+
+    thread_local StringPool* TheStringPool = nullptr;
+
+    llvm::GlobalVariable* StringPool::get(const std::string& s) {
+        auto it = globals.find(s);
+        if (it != globals.end()) {
+            return it->second;
+        }
+        auto str_const = llvm::ConstantDataArray::getString(*TheContext, s);
+        auto str = new llvm::GlobalVariable(*TheModule, str_const->getType(), true, llvm::GlobalValue::PrivateLinkage, str_const, "");
+        str->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+        str->setAlignment(llvm::Align(1));
+        globals.emplace(s, str);
+        return str;
+    }
+
+}
@@ -1,65 +1,46 @@
+#include <llvm/IR/DerivedTypes.h>
 #include <Common/Globals.h>
 #include <IR/StructType.h>
 
 namespace dmp {
 
     StructType::StructType(const std::string& n, bool p):
-        Type(TYPE_STRUCT, n)
+        Type(TYPE_STRUCT, n),
+        explicit_align(0)
     {
         if (p) {
             attr |= 1;
         }
     }
 
-    StructType::StructType(const std::vector<NameType>& m, bool p):
+    /*
+    An explicit alignment is given to the LLVM struct through a trailing zero-sized array of an N-byte vector (vectors
+    are aligned to their size). This raises the alignment of the struct to N, and rounds its size up to a multiple
+    of N, wherever the struct is placed -- in a variable, an array or another struct -- without touching the indices
+    of the members.
+    */
+    StructType::StructType(const std::vector<NameType>& m, bool p, std::size_t a):
         Type(TYPE_STRUCT),
-        members(m)
+        members(m),
+        explicit_align(a)
     {
         if (p) {
             attr |= 1;
         }
         std::vector<llvm::Type*> tv;
+        std::vector<uint64_t> key = {TYPE_STRUCT, p, a};
         for (const auto& im : m) {
             tv.push_back(im.type->llvm_type);
+            key.push_back(im.name ? im.name->id : 0);
+            key.push_back(TypeContext::component(im.type));
+            key.push_back(im.attr);
+        }
+        if (a > 1) {
+            tv.push_back(llvm::ArrayType::get(llvm::FixedVectorType::get(TheBuilder->getInt8Ty(), a), 0));
         }
         llvm_type = llvm::StructType::get(*TheContext, tv, p);
         complete = true;
-    }
-
-    bool StructType::operator==(const Type& t) const {
-        if (t.is != is) return false;
-        for (const auto& bc : being_compared) {
-            if (bc.first == this && bc.second == &t) {
-                return true;
-            }
-        }
-
-        being_compared.push_back(std::pair<const Type*, const Type*>(this, &t));
-        auto st = static_cast<const StructType*>(&t);
-        if (isPacked() != st->isPacked()) {
-            being_compared.pop_back();
-            return false;
-        }
-        if (members.size() != st->members.size()) {
-            being_compared.pop_back();
-            return false;
-        }
-        for (std::size_t i = 0; i < members.size(); i++) {
-            if (members[i].name->name != st->members[i].name->name) {
-                being_compared.pop_back();
-                return false;
-            }
-            if (*members[i].type != *st->members[i].type) {
-                being_compared.pop_back();
-                return false;
-            }
-            if (members[i].attr != st->members[i].attr) {
-                being_compared.pop_back();
-                return false;
-            }
-        }
-        being_compared.pop_back();
-        return true;
+        canon = TheTypeContext->unique(key);
     }
 
     bool StructType::construct(const std::shared_ptr<Type>& t) {
@@ -71,10 +52,14 @@ namespace dmp {
             return false;
         }
         members = st->members;
+        explicit_align = st->explicit_align;
         auto this_lt = llvm::cast<llvm::StructType>(llvm_type);
         auto that_lt = llvm::cast<llvm::StructType>(st->llvm_type);
         this_lt->setBody(that_lt->elements(), isPacked());
         complete = true;
+        if (!recursive) {
+            canon = t->canon;
+        }
         return true;
     }
 
@@ -83,11 +68,12 @@ namespace dmp {
         for (const auto& m : members) {
             ntv.push_back(NameType(m.name, m.type->clone(), m.attr));
         }
-        auto st = std::make_shared<StructType>(ntv, isPacked());
+        auto st = std::make_shared<StructType>(ntv, isPacked(), explicit_align);
         st->attr = attr;
         st->name = name;
         st->llvm_type = llvm_type;
         st->complete = complete;
+        st->canon = canon;
         return st;
     }
 
@@ -96,7 +82,7 @@ namespace dmp {
         std::vector<std::shared_ptr<Value> > cv;
         for (std::size_t i = 0; i < t->members.size(); i++) {
             if (cmap.find(i) == cmap.end()) {
-                cv.push_back(std::make_shared<Value>(t->members[i].type, llvm::Constant::getNullValue(t->members[i].type->llvm_type)));
+                cv.push_back(makePooled<Value>(t->members[i].type, llvm::Constant::getNullValue(t->members[i].type->llvm_type)));
             }
             else {
                 cv.push_back(cmap.find(i)->second);
@@ -108,9 +94,14 @@ namespace dmp {
             tsv.push_back(c->type->llvm_type);
             csv.push_back(llvm::cast<llvm::Constant>(c->llvm_value));
         }
+        if (t->explicit_align > 1) {
+            auto pad = llvm::cast<llvm::StructType>(t->llvm_type)->elements().back();
+            tsv.push_back(pad);
+            csv.push_back(llvm::Constant::getNullValue(pad));
+        }
 
         t->llvm_type = llvm::StructType::get(*TheContext, tsv, t->isPacked());
-        return std::make_shared<Value>(t, llvm::ConstantStruct::get(llvm::cast<llvm::StructType>(t->llvm_type), csv));
+        return makePooled<Value>(t, llvm::ConstantStruct::get(llvm::cast<llvm::StructType>(t->llvm_type), csv));
     }
 
 }
@@ -3,14 +3,14 @@
 
 namespace dmp {
 
-    std::vector<std::pair<const Type*, const Type*> > Type::being_compared;
-
     Type::Type(uint16_t t):
         Entity(ENTITY_TYPE),
         TypeBase(t),
         name(""),
         llvm_type(nullptr),
-        complete(false)
+        complete(false),
+        recursive(false),
+        canon(TheTypeContext->unique({t}))
     {
     }
     
@@ -19,15 +19,13 @@ namespace dmp {
         TypeBase(t),
         name(n),
         llvm_type(llvm::StructType::create(*TheContext, n)),
-        complete(false)
+        complete(false),
+        recursive(false),
+        canon(TheTypeContext->fresh())
     {
     }
 
 
-    bool Type::operator!=(const Type& t) const {
-        return !operator==(t);
-    }
-
     std::size_t Type::size() const {
         if (isUnknown() || isVoid() || isFunction() || !isComplete()) return 0;
         if (llvm_type == nullptr) return 0;
@@ -36,17 +34,12 @@ namespace dmp {
 
     std::size_t Type::alignment() const {
         if (isFunction()) {
-            return 8;
+            return TheModule->getDataLayout().getPointerABIAlignment(0).value();
         }
-        auto sz = size();
-        switch (sz) {
-            case 0 : return 0;
-            case 1 : return 1;
-            case 2 : return 2;
-            case 3 : return 4;
-            case 4 : return 4;
-            default: return 8;
+        if (size() == 0) {
+            return 0;
         }
+        return TheModule->getDataLayout().getABITypeAlign(llvm_type).value();
     }
 
     bool Type::moveDirectly() const {
@@ -0,0 +1,68 @@
+#include <IR/TypeContext.h>
+#include <IR/Type.h>
+#include <IR/UnknownType.h>
+#include <IR/VoidType.h>
+#include <IR/PrimitiveType.h>
+#include <IR/PointerType.h>
+
+namespace dmp {
+
+    thread_local TypeContext* TheTypeContext = nullptr;
+
+    std::size_t TypeContext::KeyHash::operator()(const std::vector<uint64_t>& key) const {
+        std::size_t h = key.size();
+        for (auto k : key) {
+            h ^= std::hash<uint64_t>()(k) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        }
+        return h;
+    }
+
+    TypeContext::TypeContext():
+        next(0)
+    {
+    }
+
+    uint32_t TypeContext::unique(const std::vector<uint64_t>& key) {
+        auto it = ids.find(key);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        ids.emplace(key, next);
+        return next++;
+    }
+
+    uint32_t TypeContext::fresh() {
+        return next++;
+    }
+
+    const std::shared_ptr<Type>& TypeContext::primitive(uint16_t t) {
+        if (t >= primitives.size()) {
+            primitives.resize(t+1);
+        }
+        auto& ty = primitives[t];
+        if (!ty) {
+            switch (t) {
+                case TYPE_UNKNOWN : ty = std::make_shared<UnknownType>(); break;
+                case TYPE_VOID    : ty = std::make_shared<VoidType>(); break;
+                default           : ty = std::make_shared<PrimitiveType>(t); break;
+            }
+        }
+        return ty;
+    }
+
+    const std::shared_ptr<Type>& TypeContext::pointer(const std::shared_ptr<Type>& t) {
+        auto& ty = pointers[t.get()];
+        if (!ty) {
+            ty = std::make_shared<PointerType>(t);
+        }
+        return ty;
+    }
+
+    uint64_t TypeContext::component(const std::shared_ptr<Type>& t) {
+        if (!t->isComplete()) {
+            t->recursive = true;
+        }
+        return t->canon;
+    }
+
+}
@@ -3,6 +3,7 @@
 #include <IR/UnaryOp.h>
 #include <IR/BinaryOp.h>
 #include <IR/Literal.h>
+#include <IR/ConstFold.h>
 #include <IR/PointerType.h>
 #include <IR/PrimitiveType.h>
 #include <IR/UnknownType.h>
@@ -25,13 +26,17 @@ namespace dmp {
         if (!e->type->isInt() && !e->type->isReal()){
              return ue;
         }
-        else if (e->type->isInt()) {
+        auto lit = ConstFold::unary(UNARYOP_NEGATE, e);
+        if (lit) {
+            return lit;
+        }
+        if (e->type->isInt()) {
             auto zero = llvm::ConstantInt::get(e->type->llvm_type, 0);
-            return std::make_shared<Value>(e->type, TheBuilder->CreateSub(zero, e->val()));
+            return makePooled<Value>(e->type, TheBuilder->CreateSub(zero, e->val()));
         }
         else {
             auto zero = llvm::ConstantFP::get(e->type->llvm_type, 0);
-            return std::make_shared<Value>(e->type, TheBuilder->CreateFSub(zero, e->val()));
+            return makePooled<Value>(e->type, TheBuilder->CreateFSub(zero, e->val()));
         }
     }
 
@@ -40,8 +45,12 @@ namespace dmp {
         if (!e->type->isBool()) {
             return ue;
         }
+        auto lit = ConstFold::unary(UNARYOP_NOT, e);
+        if (lit) {
+            return lit;
+        }
         auto zero = llvm::ConstantInt::get(e->type->llvm_type, 0);
-        return std::make_shared<Value>(e->type, TheBuilder->CreateICmpEQ(zero, e->val()));
+        return makePooled<Value>(e->type, TheBuilder->CreateICmpEQ(zero, e->val()));
     }
 
     std::shared_ptr<Value> UnaryOp::complement(const std::shared_ptr<Value>& e) {
@@ -49,8 +58,12 @@ namespace dmp {
         if (!e->type->isInt()) {
             return ue;
         }
+        auto lit = ConstFold::unary(UNARYOP_COMPLEMENT, e);
+        if (lit) {
+            return lit;
+        }
         auto mone = llvm::ConstantInt::get(e->type->llvm_type, -1);
-        return std::make_shared<Value>(e->type, TheBuilder->CreateXor(mone, e->val()));
+        return makePooled<Value>(e->type, TheBuilder->CreateXor(mone, e->val()));
     }
 
     std::shared_ptr<Value> UnaryOp::size(const std::shared_ptr<Type>& t) {
@@ -58,7 +71,7 @@ namespace dmp {
         std::shared_ptr<Value> ue;
         IntLiteral i(t->size());
         if (i.literal > 0) {
-            ue = std::make_shared<Value>(std::make_shared<PrimitiveType>(TYPE_UINT64), i.val());
+            ue = makePooled<Value>(TheTypeContext->primitive(TYPE_UINT64), i.val());
         }
         return ue;
     }
@@ -69,13 +82,13 @@ namespace dmp {
 
         if (e->isInstance()) {
             auto inst = static_cast<const Instance*>(e.get());
-            auto type = std::make_shared<PointerType>(inst->type);
-            ue = std::make_shared<Value>(type, inst->ptr());
+            auto type = TheTypeContext->pointer(inst->type);
+            ue = makePooled<Value>(type, inst->ptr());
         }
         else if (e->type->isInt() && e->isConst()) {
-            auto type = std::make_shared<PointerType>(std::make_shared<UnknownType>());
+            auto type = TheTypeContext->pointer(TheTypeContext->primitive(TYPE_UNKNOWN));
             auto recast = BinaryOp::recast(e, type);
-            ue = std::make_shared<Value>(type, recast->val());
+            ue = makePooled<Value>(type, recast->val());
         }
 
         return ue;
@@ -98,7 +111,7 @@ namespace dmp {
             if (pt->points_to->size() == 0) {
                 return ue;   
             }
-            auto var = std::make_shared<Variable>(STORAGE_REFERENCE, "", pt->points_to);
+            auto var = makePooled<Variable>(STORAGE_REFERENCE, "", pt->points_to);
             var->llvm_value = e->val(); // Should we align here as well ?
             ue = var;
         }
@@ -112,7 +125,7 @@ namespace dmp {
             return ue;
         }
         auto zero = llvm::ConstantInt::get(e->type->llvm_type, 0);
-        return std::make_shared<Value>(e->type, TheBuilder->CreateICmpNE(zero, e->val()));
+        return makePooled<Value>(e->type, TheBuilder->CreateICmpNE(zero, e->val()));
     }
 
     std::shared_ptr<Value> UnaryOp::isFalse(const std::shared_ptr<Value>& e) {
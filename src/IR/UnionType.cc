@@ -26,38 +26,14 @@ namespace dmp {
         tv.push_back(imax.type->llvm_type);
         llvm_type = llvm::StructType::get(*TheContext, tv, true);
         complete = true;
-    }
-
-    bool UnionType::operator==(const Type& t) const {
-        if (t.is != is) return false;
-        for (const auto& bc : being_compared) {
-            if (bc.first == this && bc.second == &t) {
-                return true;
-            }
-        }
 
-        being_compared.push_back(std::pair<const Type*, const Type*>(this, &t));
-        auto st = static_cast<const UnionType*>(&t);
-        if (members.size() != st->members.size()) {
-            being_compared.pop_back();
-            return false;
-        }
-        for (std::size_t i = 0; i < members.size(); i++) {
-            if (members[i].name->name != st->members[i].name->name) {
-                being_compared.pop_back();
-                return false;
-            }
-            if (*members[i].type != *st->members[i].type) {
-                being_compared.pop_back();
-                return false;
-            }
-            if (members[i].attr != st->members[i].attr) {
-                being_compared.pop_back();
-                return false;
-            }
+        std::vector<uint64_t> key = {TYPE_UNION};
+        for (const auto& im : members) {
+            key.push_back(im.name ? im.name->id : 0);
+            key.push_back(TypeContext::component(im.type));
+            key.push_back(im.attr);
         }
-        being_compared.pop_back();
-        return true;
+        canon = TheTypeContext->unique(key);
     }
 
     bool UnionType::construct(const std::shared_ptr<Type>& t) {
@@ -70,6 +46,9 @@ namespace dmp {
         auto that_lt = llvm::cast<llvm::StructType>(ut->llvm_type);
         this_lt->setBody(that_lt->elements(), true);
         complete = true;
+        if (!recursive) {
+            canon = t->canon;
+        }
         return true;
     }
 
@@ -83,6 +62,7 @@ namespace dmp {
         ut->name = name;
         ut->llvm_type = llvm_type;
         ut->complete = complete;
+        ut->canon = canon;
         return ut;
     }
 
@@ -102,7 +82,7 @@ namespace dmp {
         }
 
         t->llvm_type = llvm::StructType::get(*TheContext, tsv, true);
-        return std::make_shared<Value>(t, llvm::ConstantStruct::get(llvm::cast<llvm::StructType>(t->llvm_type), csv));
+        return makePooled<Value>(t, llvm::ConstantStruct::get(llvm::cast<llvm::StructType>(t->llvm_type), csv));
     }
 
 }
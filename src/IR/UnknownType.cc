@@ -10,10 +10,6 @@ namespace dmp {
         complete = true;
     }
 
-    bool UnknownType::operator==(const Type& t) const {
-        return is == t.is;
-    }
-
     bool UnknownType::construct(const std::shared_ptr<Type>&) {
         return false;
     }
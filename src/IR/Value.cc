@@ -25,13 +25,6 @@ namespace dmp {
     }
 
     void Value::setType(const std::shared_ptr<Type>& t) {
-        if (t->isPtr() && llvm::isa<llvm::StructType>(t->llvm_type)) {
-            auto pt = static_cast<PointerType*>(t.get());
-            type = t->clone();
-            type->llvm_type = llvm::PointerType::get(pt->points_to->llvm_type, 0);
-        }
-        else {
-            type = t;
-        }
+        type = PointerType::directType(t);
     }
 }
@@ -1,3 +1,5 @@
+#include <llvm/IR/Constants.h>
+#include <llvm/Transforms/Utils/Local.h>
 #include <Common/Globals.h>
 #include <IR/Variable.h>
 #include <IR/PointerType.h>
@@ -6,7 +8,8 @@
 namespace dmp {
 
     Variable::Variable(int s, const std::string& n, const std::shared_ptr<Type>& t):
-        Instance(VALUE_VAR, s, n, t)
+        Instance(VALUE_VAR, s, n, t),
+        explicit_align(0)
     {
     }
 
@@ -18,18 +21,18 @@ namespace dmp {
     }
 
     llvm::Value* Variable::ptr() const {
-        auto t = std::make_shared<PointerType>(type);
+        auto lt = llvm::PointerType::get(type->llvm_type, 0);
         if (llvm_value == nullptr) {
             return llvm_value;
         }
         else if (llvm::isa<llvm::GlobalVariable>(llvm_value)) {
             if (llvm::cast<llvm::GlobalVariable>(llvm_value)->getValueType() != type->llvm_type) {
-                return TheBuilder->CreateBitCast(llvm_value, t->llvm_type);
+                return TheBuilder->CreateBitCast(llvm_value, lt);
             }
         }
         else if (llvm::isa<llvm::AllocaInst>(llvm_value)) {
             if (llvm::cast<llvm::AllocaInst>(llvm_value)->getAllocatedType() != type->llvm_type) {
-                return TheBuilder->CreateBitCast(llvm_value, t->llvm_type);
+                return TheBuilder->CreateBitCast(llvm_value, lt);
             }
         }
         return llvm_value;
@@ -65,7 +68,9 @@ namespace dmp {
 
     void Variable::initGlobal(const std::shared_ptr<Value>& init) {
         if (isGlobal() && llvm_value != nullptr && (*init->type == *type) && init->isConst()) {
-            llvm::cast<llvm::GlobalVariable>(llvm_value)->setInitializer(llvm::cast<llvm::Constant>(init->val()));
+            auto c = llvm::cast<llvm::Constant>(init->val());
+            auto cc = conformConst(c, type->llvm_type);
+            llvm::cast<llvm::GlobalVariable>(llvm_value)->setInitializer(cc ? cc : c);
         }
     }
 
@@ -76,7 +81,7 @@ namespace dmp {
     }
 
     bool Variable::align() {
-        std::size_t al = type->alignment();
+        std::size_t al = std::max(type->alignment(), explicit_align);
         if (al == 0 || llvm_value == nullptr) {
             return false;
         }
@@ -90,4 +95,69 @@ namespace dmp {
         }
         return true;
 	}
+
+    /*
+    Alignment known for the address of the variable: that of the alloca or global itself, or, for members and
+    elements, whatever follows from the offset into the enclosing variable (1 if nothing is known about the pointer)
+    */
+    std::size_t Variable::alignment() const {
+        if (llvm_value == nullptr) {
+            return 1;
+        }
+        return llvm::getKnownAlignment(llvm_value, TheModule->getDataLayout()).value();
+    }
+
+    /*
+    Constants of compound types are built with the types of the values that go into them (and zero-filled gaps of arrays
+    are folded into a single array). Rebuild such a constant with the LLVM type of the variable it initializes, so that it
+    can be stored to or copied into the variable. Returns nullptr if this is not possible (e.g. for unions).
+    */
+    llvm::Constant* Variable::conformConst(llvm::Constant* c, llvm::Type* t) {
+
+        const auto& dl = TheModule->getDataLayout();
+        if (c->getType() == t) {
+            return c;
+        }
+        if (dl.getTypeAllocSize(c->getType()) != dl.getTypeAllocSize(t)) {
+            return nullptr;
+        }
+        if (c->isNullValue()) {
+            return llvm::Constant::getNullValue(t);
+        }
+        if (!c->getType()->isStructTy()) {
+            return nullptr;
+        }
+
+        std::vector<llvm::Constant*> elements;
+        auto n = c->getType()->getStructNumElements();
+        if (t->isArrayTy()) {
+            auto et = t->getArrayElementType();
+            for (unsigned i = 0; i < n; i++) {
+                auto e = c->getAggregateElement(i);
+                if (e->getType()->isArrayTy() && e->getType()->getArrayElementType() == et && e->isNullValue()) {
+                    elements.insert(elements.end(), e->getType()->getArrayNumElements(), llvm::Constant::getNullValue(et));
+                    continue;
+                }
+                elements.push_back(conformConst(e, et));
+                if (!elements.back()) {
+                    return nullptr;
+                }
+            }
+            if (elements.size() != t->getArrayNumElements()) {
+                return nullptr;
+            }
+            return llvm::ConstantArray::get(llvm::cast<llvm::ArrayType>(t), elements);
+        }
+        if (t->isStructTy() && t->getStructNumElements() == n) {
+            for (unsigned i = 0; i < n; i++) {
+                elements.push_back(conformConst(c->getAggregateElement(i), t->getStructElementType(i)));
+                if (!elements.back()) {
+                    return nullptr;
+                }
+            }
+            return llvm::ConstantStruct::get(llvm::cast<llvm::StructType>(t), elements);
+        }
+        return nullptr;
+    }
+
 }
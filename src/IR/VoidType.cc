@@ -10,10 +10,6 @@ namespace dmp {
         complete = true;
     }
 
-    bool VoidType::operator==(const Type& t) const { 
-        return is == t.is;
-    }
-
     bool VoidType::construct(const std::shared_ptr<Type>&) {
         return false;
     }
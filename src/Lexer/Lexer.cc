@@ -1,114 +1,58 @@
+#include <cstring>
 #include <Lexer/Lexer.h>
 #include <Lexer/TokenID.h>
 
 namespace dmp {
 
-    const std::string Lexer::bin     = "01";
-    const std::string Lexer::oct     = "01234567";
-    const std::string Lexer::dec     = "0123456789";
-    const std::string Lexer::hex     = "0123456789abcdefABCDEF";
-    const std::string Lexer::wspace  = " \t\n\r\v\f";
-    const std::string Lexer::letter  = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
-    const std::string Lexer::escchar = "\a\b\t\n\r\v\f\'\"\\";
-
-    std::map<int, std::string> Lexer::symbols = {
-        { RULE_CURLY_OPEN,       "{"        },
-        { RULE_CURLY_CLOSE,      "}"        },
-        { RULE_SQUARE_OPEN,      "["        },
-        { RULE_SQUARE_CLOSE,     "]"        },
-        { RULE_ROUND_OPEN,       "("        },
-        { RULE_ROUND_CLOSE,      ")"        },
-        { RULE_COMMA,            ","        },
-        { RULE_SEMICOLON,        ";"        },
-
-        { RULE_DECLARE,          ":"        },
-        { RULE_REPRESENTS,       "::"       },
-        { RULE_DEFINE,           ":="       },
-        { RULE_RETURNS,          "->"       },
-        { RULE_CAST,             "=>"       },
-
-        { RULE_PLUS,             "+"        },
-        { RULE_MINUS,            "-"        },
-        { RULE_MULTIPLY,         "*"        },
-        { RULE_DIVIDE,           "/"        },
-        { RULE_REMAINDER,        "%"        },
-
-        { RULE_ADDRESS,          "@"        },
-        { RULE_SIZE,             "#"        },
-        { RULE_DEREF,            "$"        },
-        { RULE_DOT,              "."        },
-
-        { RULE_COMPLEMENT,       "~"        },
-        { RULE_BIT_AND,          "&"        },
-        { RULE_BIT_OR,           "|"        },
-        { RULE_BIT_XOR,          "^"        },
-        { RULE_BIT_RIGHT,        ">>"       },
-        { RULE_BIT_LEFT,         "<<"       },
-
-        { RULE_GREATER,          ">"        },
-        { RULE_LESSER,           "<"        },
-        { RULE_GEQ,              ">="       },
-        { RULE_LEQ,              "<="       },
-        { RULE_EQUAL,            "=="       },
-        { RULE_NOT_EQUAL,        "!="       },
-        { RULE_NOT,              "!"        },
-        { RULE_LOG_AND,          "&&"       },
-        { RULE_LOG_OR,           "!!"       },
-
-        { RULE_ASSIGN,           "="        },
-        { RULE_ADD_ASSIGN,       "+="       },
-        { RULE_SUB_ASSIGN,       "-="       },
-        { RULE_MUL_ASSIGN,       "*="       },
-        { RULE_DIV_ASSIGN,       "/="       },
-        { RULE_REM_ASSIGN,       "%="       },
-        { RULE_AND_ASSIGN,       "&="       },
-        { RULE_OR_ASSIGN,        "|="       },
-        { RULE_XOR_ASSIGN,       "^="       },
-        { RULE_BIT_RIGHT_ASSIGN, ">>="      },
-        { RULE_BIT_LEFT_ASSIGN,  "<<="      },
-
-        { RULE_GENERIC_POINTER,  "@?"       }
-    };
-
-    std::map<int, std::string> Lexer::keywords = {
-        { RULE_INCLUDE,          "include"  },
-
-        { RULE_MAIN,             "main"     },
-
-        { RULE_TRUE,             "true"     },
-        { RULE_FALSE,            "false"    },
-
-        { RULE_BOOL,             "bool"     },
-        { RULE_UINT8,            "uint8"    },
-        { RULE_UINT16,           "uint16"   },
-        { RULE_UINT32,           "uint32"   },
-        { RULE_UINT64,           "uint64"   },
-        { RULE_INT8,             "int8"     },
-        { RULE_INT16,            "int16"    },
-        { RULE_INT32,            "int32"    },
-        { RULE_INT64,            "int64"    },
-        { RULE_REAL32,           "real32"   },
-        { RULE_REAL64,           "real64"   },
-        { RULE_STRUCT,           "struct"   },
-        { RULE_UNION,            "union"    },
-        { RULE_FUNCTION,         "func"     },
-        { RULE_EXTERN,           "extern"   },
-        { RULE_PACKED,           "packed"   },
-
-        { RULE_IF,               "if"       },
-        { RULE_ELSE,             "else"     },
-        { RULE_LOOP,             "loop"     },
-        { RULE_WHILE,            "while"    },
-        { RULE_FOR,              "for"      },
-        { RULE_BREAK,            "break"    },
-        { RULE_CONTINUE,         "continue" },
-        { RULE_RETURN,           "return"   }
-    };
-
-    Lexer::Lexer(std::ifstream& f):
-        file(f),
-        input_error(false),
-        next_char(0),
+    static constexpr std::array<uint16_t, 256> make_charclass() {
+        std::array<uint16_t, 256> table{};
+        for (auto c : Lexer::bin)     table[(unsigned char)c] |= CHAR_BIN;
+        for (auto c : Lexer::oct)     table[(unsigned char)c] |= CHAR_OCT;
+        for (auto c : Lexer::dec)     table[(unsigned char)c] |= CHAR_DEC;
+        for (auto c : Lexer::hex)     table[(unsigned char)c] |= CHAR_HEX;
+        for (auto c : Lexer::wspace)  table[(unsigned char)c] |= CHAR_WSPACE;
+        for (auto c : Lexer::letter)  table[(unsigned char)c] |= CHAR_LETTER;
+        for (auto c : Lexer::escchar) table[(unsigned char)c] |= CHAR_ESCCHAR;
+        for (auto c : Lexer::layout)  table[(unsigned char)c] |= CHAR_LAYOUT;
+        table['_'] |= CHAR_UNDERSCORE;
+        for (auto& cls : table) {
+            if (!(cls & CHAR_ESCCHAR)) {
+                cls |= CHAR_STRING;
+            }
+        }
+        return table;
+    }
+
+    const std::array<uint16_t, 256> Lexer::charclass = make_charclass();
+
+    /*
+
+    Characters that keep the lexer in its current state, and matching the same rule.
+    A run of such characters is consumed in one go by skip() without calling the state processors.
+    The comment and include states are handled separately in skip().
+
+    */
+
+    static constexpr uint16_t run_class(int state) {
+        switch (state) {
+            case LEXER_STATE_WS           : return CHAR_WSPACE;
+            case LEXER_STATE_WORD         : return CHAR_LETTER | CHAR_DEC | CHAR_UNDERSCORE;
+            case LEXER_STATE_NUM          : return CHAR_DEC;
+            case LEXER_STATE_INT_BIN      : return CHAR_BIN;
+            case LEXER_STATE_INT_OCT      : return CHAR_OCT;
+            case LEXER_STATE_INT_HEX      : return CHAR_HEX;
+            case LEXER_STATE_REAL_DOT     : return CHAR_DEC;
+            case LEXER_STATE_REAL_EXP     : return CHAR_DEC;
+            case LEXER_STATE_STRING_START : return CHAR_STRING;
+            default                       : return 0;
+        }
+    }
+
+    Lexer::Lexer(std::string_view src):
+        source(src),
+        position(0),
+        token_begin(0),
+        next_char(src.empty() ? EOF : (unsigned char)src[0]),
         state(LEXER_STATE_INIT),
 	start(1, 1),
 	end(1, 1),
@@ -118,7 +62,6 @@ namespace dmp {
         token_buffer("")
     {
         populate_state_processors();
-        read();
     }
 
     int Lexer::lex() {
@@ -166,6 +109,7 @@ namespace dmp {
                 case RULE_FUNCTION         : return TOKEN_FUNCTION;
                 case RULE_EXTERN           : return TOKEN_EXTERN;
                 case RULE_PACKED           : return TOKEN_PACKED;
+                case RULE_ALIGN            : return TOKEN_ALIGN;
 
                 case RULE_IF               : return TOKEN_IF;
                 case RULE_ELSE             : return TOKEN_ELSE;
@@ -240,26 +184,37 @@ namespace dmp {
 
     void Lexer::read() {
 
-        next_char = file.get();
-        if (!file.eof() && (file.fail() || file.bad()) ) {
-            input_error = true;
+        if (position < source.size()) {
+            position++;
         }
+        next_char = position < source.size() ? (unsigned char)source[position] : EOF;
 
     }
 
     void Lexer::append() {
 
-        if (token_buffer == "") {
+        if (token_buffer.empty()) {
             start = next;
+            token_begin = position;
         }
+
+        if (next_char != EOF) {
+            token_buffer = source.substr(token_begin, position - token_begin + 1);
+        }
+        advance(next_char);
+    }
+
+    void Lexer::advance(int c) {
+
 	last = end;
 	end = next;
 
-        if (next_char != EOF) {
-            token_buffer += char(next_char);
+        if (c != EOF && !in_class(c, CHAR_LAYOUT)) {
+            next.column++;
+            return;
         }
 
-        switch (next_char) {
+        switch (c) {
             case '\n': 
                 next.line++; 
                 next.column = 1;
@@ -273,15 +228,61 @@ namespace dmp {
             case '\v':
                 next.line++;
                 break;
-            case EOF:
+        }
+    }
+
+    void Lexer::skip() {
+
+        const auto size = source.size();
+        const auto len = token_buffer.length();
+        auto n = position + 1;
+
+        if (n >= size) {
+            return;
+        }
+
+        switch (state) {
+            case LEXER_STATE_INCLUDE:
+            case LEXER_STATE_ONELINE_COMMENT: {
+                if (token_buffer.back() == '\n') {
+                    return;
+                }
+                auto nl = std::memchr(source.data() + n, '\n', size - n);
+                n = (nl != nullptr ? static_cast<const char*>(nl) - source.data() : size);
+                break;
+            }
+            case LEXER_STATE_MULTILINE_COMMENT: {
+                if (len < 3 || token_buffer[len-1] == '*' || (token_buffer[len-2] == '*' && token_buffer[len-1] == '/')) {
+                    return;
+                }
+                auto star = std::memchr(source.data() + n, '*', size - n);
+                n = (star != nullptr ? static_cast<const char*>(star) - source.data() : size);
                 break;
-            default:
-                next.column++;
+            }
+            default: {
+                auto cls = run_class(state);
+                if (cls == 0) {
+                    return;
+                }
+                while (n < size && (charclass[(unsigned char)source[n]] & cls)) {
+                    n++;
+                }
+            }
         }
+
+        if (n == position + 1) {
+            return;
+        }
+        for (auto i = position + 1; i < n; i++) {
+            advance((unsigned char)source[i]);
+        }
+        position = n - 1;
+        next_char = (unsigned char)source[position];
+        token_buffer = source.substr(token_begin, position - token_begin + 1);
     }
 
     void Lexer::unappend() {
-        token_buffer.erase(token_buffer.end()-1);
+        token_buffer.remove_suffix(1);
         next = end;
 	end = last;
     }
@@ -291,13 +292,14 @@ namespace dmp {
         append();
 
         if (next_char == EOF) {
-            token_string = token_buffer = "";
-            return (input_error ? RULE_ERROR : RULE_EOF);
+            token_string = token_buffer = std::string_view();
+            return RULE_EOF;
         }
 
         auto m = match(false);
 	if (m != RULE_UNDEF) {
             for (; m != RULE_UNDEF; m = match(false)) {
+                skip();
                 read();    
                 append();
                 if (next_char == EOF) {
@@ -308,13 +310,10 @@ namespace dmp {
                 unappend();
                 m = match(true);
             }
-	    else if (input_error) {
-                return RULE_ERROR;
-            }
 	}
 
         token_string = token_buffer;
-        token_buffer = "";
+        token_buffer = std::string_view();
         state = LEXER_STATE_INIT;
         return m;
 
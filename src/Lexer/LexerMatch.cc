@@ -1,33 +1,189 @@
+#include <cstdint>
 #include <Lexer/Lexer.h>
 
 namespace dmp {
 
-    static int process_LEXER_STATE_INIT(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_INCLUDE(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_WS(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_ONELINE_COMMENT(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_MULTILINE_COMMENT(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_CHAR_START(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_CHAR_NEXT(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_CHAR_ESC(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_CHAR_ESC_HEX(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_CHAR_DONE(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_STRING_START(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_STRING_ESC(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_STRING_ESC_HEX(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_STRING_DONE(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_NUM(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_INT_BIN(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_INT_OCT(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_INT_HEX(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_REAL_DOT(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_REAL_EXP(bool exact, const std::string& token_buffer, int& state);
-    static int process_LEXER_STATE_WORD(bool exact, const std::string& token_buffer, int& state);
+    static int process_LEXER_STATE_INIT(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_INCLUDE(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_WS(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_ONELINE_COMMENT(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_MULTILINE_COMMENT(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_CHAR_START(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_CHAR_NEXT(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_CHAR_ESC(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_CHAR_ESC_HEX(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_CHAR_DONE(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_STRING_START(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_STRING_ESC(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_STRING_ESC_HEX(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_STRING_DONE(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_NUM(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_INT_BIN(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_INT_OCT(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_INT_HEX(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_REAL_DOT(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_REAL_EXP(bool exact, std::string_view token_buffer, int& state);
+    static int process_LEXER_STATE_WORD(bool exact, std::string_view token_buffer, int& state);
 
     static inline int select_rule(bool selector, int rule_if_true) {
         return selector ? rule_if_true : RULE_UNDEF;
     }
 
+    /*
+
+    Keywords are looked up through a perfect hash of Lexer::keywords. 
+    The hash seed is searched for at compile time such that every keyword lands in its own slot.
+
+    */
+
+    static constexpr std::size_t KEYWORD_TABLE_SIZE = 128;
+
+    static constexpr uint32_t keyword_hash(uint32_t seed, std::string_view str) {
+        uint32_t h = 2166136261u ^ seed;
+        for (auto c : str) {
+            h ^= (unsigned char)c;
+            h *= 16777619u;
+        }
+        return (h ^ (h >> 16)) & (KEYWORD_TABLE_SIZE - 1);
+    }
+
+    static constexpr std::size_t keyword_max_length() {
+        std::size_t len = 0;
+        for (const auto& kw : Lexer::keywords) {
+            if (kw.text.length() > len) {
+                len = kw.text.length();
+            }
+        }
+        return len;
+    }
+
+    static constexpr uint32_t keyword_seed() {
+        for (uint32_t seed = 0; seed < 65536; seed++) {
+            bool used[KEYWORD_TABLE_SIZE] = {};
+            bool collision = false;
+            for (const auto& kw : Lexer::keywords) {
+                auto h = keyword_hash(seed, kw.text);
+                if (used[h]) {
+                    collision = true;
+                    break;
+                }
+                used[h] = true;
+            }
+            if (!collision) {
+                return seed;
+            }
+        }
+        return UINT32_MAX;
+    }
+
+    struct KeywordTable {
+
+        uint32_t seed;
+        std::size_t max_length;
+        int16_t slot[KEYWORD_TABLE_SIZE];
+
+    };
+
+    static constexpr KeywordTable make_keyword_table() {
+        KeywordTable table{};
+        table.seed = keyword_seed();
+        table.max_length = keyword_max_length();
+        for (auto& sl : table.slot) {
+            sl = -1;
+        }
+        for (std::size_t i = 0; i < sizeof(Lexer::keywords)/sizeof(Lexer::keywords[0]); i++) {
+            table.slot[keyword_hash(table.seed, Lexer::keywords[i].text)] = i;
+        }
+        return table;
+    }
+
+    static constexpr KeywordTable keyword_table = make_keyword_table();
+    static_assert(keyword_table.seed != UINT32_MAX, "Unable to find a perfect hash for the keywords");
+
+    static inline int keyword(std::string_view token_buffer) {
+        if (token_buffer.length() > keyword_table.max_length) {
+            return RULE_UNDEF;
+        }
+        auto sl = keyword_table.slot[keyword_hash(keyword_table.seed, token_buffer)];
+        if (sl < 0 || Lexer::keywords[sl].text != token_buffer) {
+            return RULE_UNDEF;
+        }
+        return Lexer::keywords[sl].rule;
+    }
+
+    /*
+
+    Symbols are matched by walking a trie built from Lexer::symbols at compile time.
+    Each character of a symbol is mapped to a column of the trie; node 0 is the root.
+    The exact rule of a node is the symbol that ends there, if any. 
+    The prefix rule of a node is a symbol that starts with the characters leading up to that node.
+
+    */
+
+    static constexpr std::size_t SYMBOL_TRIE_NODES   = 64;
+    static constexpr std::size_t SYMBOL_TRIE_COLUMNS = 32;
+
+    struct SymbolTrie {
+
+        bool valid;
+        uint8_t column[256];
+        uint8_t next[SYMBOL_TRIE_NODES][SYMBOL_TRIE_COLUMNS];
+        int exact[SYMBOL_TRIE_NODES];
+        int prefix[SYMBOL_TRIE_NODES];
+
+    };
+
+    static constexpr SymbolTrie make_symbol_trie() {
+        SymbolTrie trie{};
+        for (std::size_t i = 0; i < SYMBOL_TRIE_NODES; i++) {
+            trie.exact[i] = RULE_UNDEF;
+            trie.prefix[i] = RULE_UNDEF;
+        }
+
+        std::size_t ncolumns = 1;
+        std::size_t nnodes = 1;
+        for (const auto& sym : Lexer::symbols) {
+            std::size_t node = 0;
+            for (auto c : sym.text) {
+                auto& col = trie.column[(unsigned char)c];
+                if (col == 0) {
+                    if (ncolumns == SYMBOL_TRIE_COLUMNS) {
+                        return trie;
+                    }
+                    col = ncolumns++;
+                }
+                if (trie.next[node][col] == 0) {
+                    if (nnodes == SYMBOL_TRIE_NODES) {
+                        return trie;
+                    }
+                    trie.next[node][col] = nnodes++;
+                }
+                node = trie.next[node][col];
+                if (trie.prefix[node] == RULE_UNDEF) {
+                    trie.prefix[node] = sym.rule;
+                }
+            }
+            trie.exact[node] = sym.rule;
+            trie.prefix[node] = sym.rule;
+        }
+        trie.valid = true;
+        return trie;
+    }
+
+    static constexpr SymbolTrie symbol_trie = make_symbol_trie();
+    static_assert(symbol_trie.valid, "Symbol trie is too small to hold all the symbols");
+
+    static inline int symbol(bool exact, std::string_view token_buffer) {
+        std::size_t node = 0;
+        for (auto c : token_buffer) {
+            node = symbol_trie.next[node][symbol_trie.column[(unsigned char)c]];
+            if (node == 0) {
+                return RULE_UNDEF;
+            }
+        }
+        return exact ? symbol_trie.exact[node] : symbol_trie.prefix[node];
+    }
+
     void Lexer::populate_state_processors() {
         state_processors[LEXER_STATE_INIT]              = process_LEXER_STATE_INIT;
         state_processors[LEXER_STATE_INCLUDE]           = process_LEXER_STATE_INCLUDE;
@@ -54,7 +210,7 @@ namespace dmp {
 
     int Lexer::match(bool exact) {
 
-        if (token_buffer == "") {
+        if (token_buffer.empty()) {
             return RULE_UNDEF;
         }
 
@@ -62,23 +218,23 @@ namespace dmp {
 
     }
 
-    int process_LEXER_STATE_INIT(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_INIT(bool exact, std::string_view token_buffer, int& state) {
 
         auto len = token_buffer.length();
         const auto& last_ch = token_buffer.back();
 
 	if (token_buffer.length() == 1) {
-            if (Lexer::wspace.find(last_ch) != std::string::npos) {
+            if (Lexer::in_class(last_ch, CHAR_WSPACE)) {
                 state = LEXER_STATE_WS;
 		return RULE_WS;
             }
-	    else if (Lexer::letter.find(last_ch) != std::string::npos || last_ch == '_') {
+	    else if (Lexer::in_class(last_ch, CHAR_LETTER | CHAR_UNDERSCORE)) {
                 state = LEXER_STATE_WORD;
 		// We don't have any 1-char keywords
 		// If there are any, they should be tested here
 		return RULE_IDENT;
             }
-	    else if (Lexer::dec.find(last_ch) != std::string::npos) {
+	    else if (Lexer::in_class(last_ch, CHAR_DEC)) {
                 state = LEXER_STATE_NUM;
                 return RULE_INT;
             }
@@ -103,59 +259,41 @@ namespace dmp {
                     return exact ? RULE_UNDEF : RULE_MULTILINE_COMMENT;
                 }
             }
-	    else if (token_buffer[0] == '.' && Lexer::dec.find(last_ch) != std::string::npos) {
+	    else if (token_buffer[0] == '.' && Lexer::in_class(last_ch, CHAR_DEC)) {
                 state = LEXER_STATE_REAL_DOT;
                 return exact ? RULE_UNDEF : RULE_REAL;
             }
         }
 
-	for (const auto& sym_pair : Lexer::symbols) {
-            const auto& sym = sym_pair.second;
-            if (exact) {
-                if (token_buffer == sym) {
-                    return sym_pair.first;
-                }
-            }
-            else {
-                if (sym.find(token_buffer) == 0) {
-                    return sym_pair.first;
-                }
-            }
-        }
-
-	return RULE_UNDEF;
+	return symbol(exact, token_buffer);
     }
 
-    int process_LEXER_STATE_INCLUDE(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_INCLUDE(bool exact, std::string_view token_buffer, int& state) {
         return token_buffer.back() != '\n' ? RULE_FILENAME : RULE_UNDEF;
     }
 
-    int process_LEXER_STATE_WS(bool, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_WS(bool, std::string_view token_buffer, int& state) {
         const auto& last_ch = token_buffer.back();
-        return select_rule(Lexer::wspace.find(last_ch) != std::string::npos, RULE_WS);
+        return select_rule(Lexer::in_class(last_ch, CHAR_WSPACE), RULE_WS);
     }
 
-    int process_LEXER_STATE_WORD(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_WORD(bool exact, std::string_view token_buffer, int& state) {
 
         const auto& last_ch = token_buffer.back();
 
         if (exact) {
-            for (const auto& keyword_pair : Lexer::keywords) {
-                const auto& keyword = keyword_pair.second;
-                if (token_buffer == keyword) {
-                    return keyword_pair.first;
-                }
+            auto kw = keyword(token_buffer);
+            if (kw != RULE_UNDEF) {
+                return kw;
             }
         }
 
-        bool is_ident = Lexer::letter.find(last_ch) != std::string::npos ||
-                        Lexer::dec.find(last_ch)    != std::string::npos ||
-                        last_ch == '_';
+        bool is_ident = Lexer::in_class(last_ch, CHAR_LETTER | CHAR_DEC | CHAR_UNDERSCORE);
 
         return select_rule(is_ident, RULE_IDENT);
     }
 
-    int process_LEXER_STATE_ONELINE_COMMENT(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_ONELINE_COMMENT(bool exact, std::string_view token_buffer, int& state) {
 
         auto len = token_buffer.length();
         const auto& last_ch = token_buffer.back();
@@ -169,7 +307,7 @@ namespace dmp {
         return RULE_UNDEF;
     }
 
-    int process_LEXER_STATE_MULTILINE_COMMENT(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_MULTILINE_COMMENT(bool exact, std::string_view token_buffer, int& state) {
 
         auto len = token_buffer.length();
         const auto& last_ch = token_buffer.back();
@@ -188,7 +326,7 @@ namespace dmp {
         return RULE_UNDEF;	    
     }   
 
-    int process_LEXER_STATE_NUM(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_NUM(bool exact, std::string_view token_buffer, int& state) {
 
         auto len = token_buffer.length();
         const auto& last_ch = token_buffer.back();
@@ -200,9 +338,9 @@ namespace dmp {
                 case 'x' : state = LEXER_STATE_INT_HEX ; return select_rule(!exact, RULE_INT);
                 case '.' : state = LEXER_STATE_REAL_DOT; return select_rule(!exact, RULE_REAL);
             }
-	    return select_rule(Lexer::dec.find(last_ch) != std::string::npos, RULE_INT);
+	    return select_rule(Lexer::in_class(last_ch, CHAR_DEC), RULE_INT);
         }
-        else if (Lexer::dec.find(last_ch) != std::string::npos) {
+        else if (Lexer::in_class(last_ch, CHAR_DEC)) {
             return RULE_INT;
         } 
 	else if (last_ch == '.') {
@@ -216,38 +354,38 @@ namespace dmp {
         return RULE_UNDEF;
     }
 
-    int process_LEXER_STATE_INT_BIN(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_INT_BIN(bool exact, std::string_view token_buffer, int& state) {
 
         const auto& last_ch = token_buffer.back();
-        return select_rule(Lexer::bin.find(last_ch) != std::string::npos, RULE_INT);
+        return select_rule(Lexer::in_class(last_ch, CHAR_BIN), RULE_INT);
     }
 
-    int process_LEXER_STATE_INT_OCT(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_INT_OCT(bool exact, std::string_view token_buffer, int& state) {
 
         const auto& last_ch = token_buffer.back();
-        return select_rule(Lexer::oct.find(last_ch) != std::string::npos, RULE_INT);
+        return select_rule(Lexer::in_class(last_ch, CHAR_OCT), RULE_INT);
     }
 
-    int process_LEXER_STATE_INT_HEX(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_INT_HEX(bool exact, std::string_view token_buffer, int& state) {
 
         const auto& last_ch = token_buffer.back();
-        return select_rule(Lexer::hex.find(last_ch) != std::string::npos, RULE_INT);
+        return select_rule(Lexer::in_class(last_ch, CHAR_HEX), RULE_INT);
     }    
 
-    int process_LEXER_STATE_REAL_DOT(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_REAL_DOT(bool exact, std::string_view token_buffer, int& state) {
 
         const auto& last_ch = token_buffer.back();
 	if (last_ch == 'e' || last_ch == 'E') {
             state = LEXER_STATE_REAL_EXP;
 	    return select_rule(!exact, RULE_REAL);
         }
-	else if (Lexer::dec.find(last_ch) != std::string::npos) {
+	else if (Lexer::in_class(last_ch, CHAR_DEC)) {
             return RULE_REAL;
         }
         return RULE_UNDEF;
     }
 
-    int process_LEXER_STATE_REAL_EXP(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_REAL_EXP(bool exact, std::string_view token_buffer, int& state) {
 
         auto len = token_buffer.length();
         const auto& last_ch = token_buffer.back();
@@ -257,13 +395,13 @@ namespace dmp {
                 return select_rule(!exact, RULE_REAL);
             }
         }
-        else if (Lexer::dec.find(last_ch) != std::string::npos) {
+        else if (Lexer::in_class(last_ch, CHAR_DEC)) {
             return RULE_REAL;
         }
         return RULE_UNDEF;
     }
 
-    int process_LEXER_STATE_CHAR_START(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_CHAR_START(bool exact, std::string_view token_buffer, int& state) {
 
         auto len = token_buffer.length();
         const auto& last_ch = token_buffer.back();
@@ -272,14 +410,14 @@ namespace dmp {
             state = LEXER_STATE_CHAR_ESC;
             return select_rule(!exact, RULE_CHAR);
         }
-	else if (Lexer::escchar.find(last_ch) != std::string::npos) {
+	else if (Lexer::in_class(last_ch, CHAR_ESCCHAR)) {
             return RULE_UNDEF;
         }
         state = LEXER_STATE_CHAR_NEXT;
         return select_rule(!exact, RULE_CHAR);
     }
 
-    int process_LEXER_STATE_CHAR_NEXT(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_CHAR_NEXT(bool exact, std::string_view token_buffer, int& state) {
 
         auto len = token_buffer.length();
         const auto& last_ch = token_buffer.back();
@@ -291,7 +429,7 @@ namespace dmp {
 	return RULE_UNDEF;
     }
 
-    int process_LEXER_STATE_CHAR_ESC(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_CHAR_ESC(bool exact, std::string_view token_buffer, int& state) {
 
         auto len = token_buffer.length();
         const auto& last_ch = token_buffer.back();
@@ -317,12 +455,12 @@ namespace dmp {
         return RULE_UNDEF;	    
     }
 
-    int process_LEXER_STATE_CHAR_ESC_HEX(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_CHAR_ESC_HEX(bool exact, std::string_view token_buffer, int& state) {
 
         auto len = token_buffer.length();
         const auto& last_ch = token_buffer.back();
 
-        if (Lexer::hex.find(last_ch)) {
+        if (Lexer::in_class(last_ch, CHAR_HEX)) {
             if (token_buffer[len-2] == 'x') {
                 return select_rule(!exact, RULE_CHAR);
             }
@@ -334,14 +472,14 @@ namespace dmp {
         return RULE_UNDEF;	    
     }
 
-    int process_LEXER_STATE_CHAR_DONE(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_CHAR_DONE(bool exact, std::string_view token_buffer, int& state) {
 
         auto len = token_buffer.length();
         const auto& last_ch = token_buffer.back();
         return select_rule(exact, RULE_CHAR);
     }
 
-    int process_LEXER_STATE_STRING_START(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_STRING_START(bool exact, std::string_view token_buffer, int& state) {
 
         auto len = token_buffer.length();
         const auto& last_ch = token_buffer.back();
@@ -354,13 +492,13 @@ namespace dmp {
             state = LEXER_STATE_STRING_DONE;
             return RULE_STRING;
         }
-	else if (Lexer::escchar.find(last_ch) != std::string::npos) {
+	else if (Lexer::in_class(last_ch, CHAR_ESCCHAR)) {
             return RULE_UNDEF;
         }
         return select_rule(!exact, RULE_STRING);
     }
 
-    int process_LEXER_STATE_STRING_ESC(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_STRING_ESC(bool exact, std::string_view token_buffer, int& state) {
 
         auto len = token_buffer.length();
         const auto& last_ch = token_buffer.back();
@@ -386,12 +524,12 @@ namespace dmp {
         return RULE_UNDEF;
     }
 
-    int process_LEXER_STATE_STRING_ESC_HEX(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_STRING_ESC_HEX(bool exact, std::string_view token_buffer, int& state) {
 
         auto len = token_buffer.length();
         const auto& last_ch = token_buffer.back();
 
-        if (Lexer::hex.find(last_ch)) {
+        if (Lexer::in_class(last_ch, CHAR_HEX)) {
             if (token_buffer[len-2] == 'x') {
                 return select_rule(!exact, RULE_STRING);
             }
@@ -403,7 +541,7 @@ namespace dmp {
         return RULE_UNDEF;
     }
 
-    int process_LEXER_STATE_STRING_DONE(bool exact, const std::string& token_buffer, int& state) {
+    int process_LEXER_STATE_STRING_DONE(bool exact, std::string_view token_buffer, int& state) {
 
         auto len = token_buffer.length();
         const auto& last_ch = token_buffer.back();
@@ -0,0 +1,87 @@
+#include <Lexer/TokenStream.h>
+
+namespace dmp {
+
+    TokenStream::TokenStream():
+        first(0)
+    {
+    }
+
+    std::size_t TokenStream::size() const {
+        return first + kinds.size();
+    }
+
+    void TokenStream::push_back(int k, uint16_t f, std::string_view src, std::string_view txt, const Coordinate& s, const Coordinate& e) {
+        if (f >= sources.size()) {
+            sources.resize(f+1);
+        }
+        sources[f] = src;
+
+        kinds.push_back(k);
+        files.push_back(f);
+        offsets.push_back(txt.empty() ? 0 : txt.data() - src.data());
+        lengths.push_back(txt.length());
+        starts.push_back(pack(s));
+        ends.push_back(pack(e));
+    }
+
+    void TokenStream::consume(std::size_t upto) {
+        if (marks.size() > 1 || upto <= first) {
+            return;
+        }
+        std::size_t n = upto - first;
+        if (n < 1024 || 2*n < kinds.size()) {
+            return;
+        }
+        kinds.erase(kinds.begin(), kinds.begin()+n);
+        files.erase(files.begin(), files.begin()+n);
+        offsets.erase(offsets.begin(), offsets.begin()+n);
+        lengths.erase(lengths.begin(), lengths.begin()+n);
+        starts.erase(starts.begin(), starts.begin()+n);
+        ends.erase(ends.begin(), ends.begin()+n);
+        first = upto;
+    }
+
+    std::size_t TokenStream::mark() {
+        marks.push_back(size());
+        return marks.back();
+    }
+
+    void TokenStream::rewind() {
+        if (marks.empty()) {
+            return;
+        }
+        if (marks.back() < first) {
+            first = marks.back();
+        }
+        std::size_t n = marks.back() - first;
+        marks.pop_back();
+        kinds.resize(n);
+        files.resize(n);
+        offsets.resize(n);
+        lengths.resize(n);
+        starts.resize(n);
+        ends.resize(n);
+    }
+
+    int TokenStream::kind(std::size_t i) const {
+        return kinds[i-first];
+    }
+
+    std::string_view TokenStream::text(std::size_t i) const {
+        return sources[files[i-first]].substr(offsets[i-first], lengths[i-first]);
+    }
+
+    std::string TokenStream::str(std::size_t i) const {
+        return std::string(text(i));
+    }
+
+    Location TokenStream::loc(std::size_t i) const {
+        return Location(files[i-first], unpack(starts[i-first]), unpack(ends[i-first]));
+    }
+
+    Token TokenStream::token(std::size_t i) const {
+        return Token(kind(i), str(i), loc(i));
+    }
+
+}
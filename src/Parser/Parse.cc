@@ -1,50 +1,54 @@
-#include <fstream>
 #include <IO/Location.h>
 #include <IO/InputFile.h>
 #include <Parser/Parser.h>
 #include <Lexer/TokenID.h>
+#include <AST/ExprNode.h>
   
 namespace dmp {
 
-    Parser::Parser(InputManager* in, AST* tree):
-        Pass(in, tree, nullptr)
+    Parser::Parser(InputManager* in, AST* tree, bool m, const IncludeCache* c):
+        Pass(in, tree, nullptr),
+        nParsed(0),
+        nSucceeded(0),
+        memoize(m),
+        cache(c)
     {
     }
 
     void Parser::fail() {
         nParsed = 0;
-        result.reset();
+        result = nullptr;
     }
 
     bool Parser::success(std::size_t n) {
         nParsed = n;
+        nSucceeded++;
         return Pass::success();
     }
 
     bool Parser::run() {
-        tokens.push_back(scan());
-        bool status = parseProg(tokens.size()-1);
-        tokens.pop_back();
+        auto mark = tokens.mark();
+        scan();
+        bool status = parseProg(mark);
+        tokens.rewind();
+        memo.clear();
         return status;
     }
 
-    std::shared_ptr<Token> Parser::scan() {
+    void Parser::scan() {
         const auto& scanner = input->currentInputFile->scanner;
         auto type = scanner->lex();
-        auto str = scanner->token_string;
-        Location loc(input->currentInputFile->index, scanner->start, scanner->end);
-
-        return std::make_shared<Token>(type, str, loc);
+        tokens.push_back(type, input->currentInputFile->index, scanner->source, scanner->token_string, scanner->start, scanner->end);
     }
 
     bool Parser::parseToken(std::size_t it, int t) {
-        if (tokens[it]->is != t) {
+        if (tokens.kind(it) != t) {
             return false;
         }
 
         if (t != TOKEN_UNDEF && t != TOKEN_ERROR && t != TOKEN_EOF) {
             if (it == tokens.size() - 1) {
-                tokens.push_back(scan());
+                scan();
             }
             return true;
         }
@@ -53,43 +57,57 @@ namespace dmp {
             return true;
         }
 
-        switch (tokens[it]->is) {
-            case TOKEN_UNDEF : errors.push_back(Error(tokens[it]->loc, "Invalid token " + tokens[it]->str)); break;
-            case TOKEN_ERROR : errors.push_back(Error(tokens[it]->loc, "Unexpected termination of input"));
+        switch (tokens.kind(it)) {
+            case TOKEN_UNDEF : errors.push_back(Error(tokens.loc(it), "Invalid token " + tokens.str(it))); break;
+            case TOKEN_ERROR : errors.push_back(Error(tokens.loc(it), "Unexpected termination of input"));
         }
         return true;
     }
 
-    bool Parser::isUnaryOp(std::size_t it) {
+    bool Parser::parseMemoized(int rule, std::size_t it, bool (Parser::*parse)(std::size_t)) {
 
-        return (parseToken(it, TOKEN_PLUS)       || parseToken(it, TOKEN_MINUS) ||
-                parseToken(it, TOKEN_COMPLEMENT) || parseToken(it, TOKEN_NOT)   ||
-                parseToken(it, TOKEN_ADDRESS)    || parseToken(it, TOKEN_SIZE));
+        if (!memoize) {
+            return (this->*parse)(it);
+        }
 
-    }
+        auto key = it * MEMO_NRULES + rule;
+        auto entry = memo.find(key);
+        if (entry != memo.end()) {
+            const auto& m = entry->second;
+            if (m.cleared) {
+                errors = m.errors;
+            }
+            else {
+                errors.insert(errors.end(), m.errors.begin(), m.errors.end());
+            }
+            nParsed = m.nParsed;
+            result = m.result;
+            return m.status;
+        }
 
-    bool Parser::isBinaryMathOp(std::size_t it) {
+        auto nerrors = errors.size();
+        auto nsucceeded = nSucceeded;
+        bool status = (this->*parse)(it);
 
-        return (parseToken(it, TOKEN_LOG_OR)     || parseToken(it, TOKEN_LOG_AND)    ||
-                parseToken(it, TOKEN_EQUAL)      || parseToken(it, TOKEN_NOT_EQUAL)  ||
-                parseToken(it, TOKEN_GREATER)    || parseToken(it, TOKEN_LESSER)     ||
-                parseToken(it, TOKEN_GEQ)        || parseToken(it, TOKEN_LEQ)        ||
-                parseToken(it, TOKEN_BIT_OR)     || parseToken(it, TOKEN_BIT_XOR)    ||
-                parseToken(it, TOKEN_BIT_AND)    || parseToken(it, TOKEN_BIT_LEFT)   ||
-                parseToken(it, TOKEN_BIT_RIGHT)  || parseToken(it, TOKEN_PLUS)       ||
-                parseToken(it, TOKEN_MINUS)      || parseToken(it, TOKEN_MULTIPLY)   ||
-                parseToken(it, TOKEN_DIVIDE)     || parseToken(it, TOKEN_REMAINDER));
+        auto& m = memo[key];
+        m.status = status;
+        m.cleared = nSucceeded != nsucceeded;
+        m.nParsed = nParsed;
+        m.result = result;
+        m.errors.assign(errors.begin() + (m.cleared ? 0 : nerrors), errors.end());
+        return status;
+    }
 
+    bool Parser::isUnaryOp(std::size_t it) {
+        return ExprNode::isUnop(tokens.kind(it)) && parseToken(it, tokens.kind(it));
     }
 
-    bool Parser::isAssigner(std::size_t it) {
+    bool Parser::isBinaryMathOp(std::size_t it) {
+        return ExprNode::isBinop(tokens.kind(it)) && parseToken(it, tokens.kind(it));
+    }
 
-        return (parseToken(it, TOKEN_ADD_ASSIGN) || parseToken(it, TOKEN_SUB_ASSIGN) ||
-                parseToken(it, TOKEN_MUL_ASSIGN) || parseToken(it, TOKEN_DIV_ASSIGN) ||
-                parseToken(it, TOKEN_REM_ASSIGN) || parseToken(it, TOKEN_AND_ASSIGN) ||
-                parseToken(it, TOKEN_XOR_ASSIGN) || parseToken(it, TOKEN_OR_ASSIGN ) ||
-                parseToken(it, TOKEN_BIT_RIGHT_ASSIGN) || parseToken(it, TOKEN_BIT_LEFT_ASSIGN)  || 
-                parseToken(it, TOKEN_ASSIGN));
+    bool Parser::isAssigner(std::size_t it) {
+        return ExprNode::isAssop(tokens.kind(it)) && parseToken(it, tokens.kind(it));
     }
 
     bool Parser::isLiteral(std::size_t it) {
@@ -21,24 +21,24 @@ namespace dmp {
         if (isLiteral(it)) {
             std::string err = "";
             if (parseToken(it, TOKEN_INT)) {
-                result = IntNode::construct(tokens[it]);
+                result = IntNode::construct(ast->arena, tokens.token(it));
                 err = "Integer out of range";
             }
             else if (parseToken(it, TOKEN_REAL)) {
-                result = RealNode::construct(tokens[it]);
+                result = RealNode::construct(ast->arena, tokens.token(it));
                 err = "Real out of range";
             }
             else if (parseToken(it, TOKEN_CHAR)) {
-                result = CharNode::construct(tokens[it]);
+                result = CharNode::construct(ast->arena, tokens.token(it));
                 err = "Multi-byte characters not allowed";
             }
             else if (parseToken(it, TOKEN_TRUE) || parseToken(it, TOKEN_FALSE)) {
-                result = BoolNode::construct(tokens[it]);
+                result = BoolNode::construct(ast->arena, tokens.token(it));
             }
             else {
-                auto strnode = StringNode::construct(tokens[it]);
+                auto strnode = StringNode::construct(ast->arena, tokens.token(it));
                 while (parseToken(it+n+1, TOKEN_STRING)) {
-                    auto next_strnode = StringNode::construct(tokens[it+n+1]);
+                    auto next_strnode = StringNode::construct(ast->arena, tokens.token(it+n+1));
                     strnode->str += next_strnode->str;
                     strnode->literal += next_strnode->literal;
                     strnode->loc.end = next_strnode->loc.end;
@@ -47,7 +47,7 @@ namespace dmp {
                 result = strnode;
             }
             if (!result) {
-                return error(tokens[it], err);
+                return error(tokens.loc(it), err);
             }
             n++;
         }
@@ -71,7 +71,7 @@ namespace dmp {
     bool Parser::parseUnaryNoRecast(std::size_t it) {
 
         std::size_t n = 0;
-        auto loc = tokens[it]->loc;
+        auto loc = tokens.loc(it);
 
         if (parseLiteral(it) || parsePreOpUnary(it)) {
             n += nParsed;
@@ -81,18 +81,18 @@ namespace dmp {
         if (parseToken(it, TOKEN_ROUND_OPEN)) {
             n++;
             if (!parseExpr(it+n)) {
-                return error(tokens[it+n], "Failed to parse expression after \'(\'");
+                return error(tokens.loc(it+n), "Failed to parse expression after \'(\'");
             }
             n += nParsed;
             if (!parseToken(it+n, TOKEN_ROUND_CLOSE)) {
-                return error(tokens[it+n], "Expecting \')\'");
+                return error(tokens.loc(it+n), "Expecting \')\'");
             }
-            loc.end = tokens[it+n]->loc.end;
+            loc.end = tokens.loc(it+n).end;
             result->loc = loc;
             n++;
         }
         else if (parseToken(it, TOKEN_IDENT)) {
-            result = std::make_shared<Identifier>(tokens[it+n]->str, tokens[it+n]->loc);
+            result = ast->make<Identifier>(tokens.str(it+n), tokens.loc(it+n));
             n++;
         }
         else {
@@ -121,6 +121,10 @@ namespace dmp {
     */
 
     bool Parser::parseUnary(std::size_t it) {
+        return parseMemoized(MEMO_UNARY, it, &Parser::parseUnaryNoMemo);
+    }
+
+    bool Parser::parseUnaryNoMemo(std::size_t it) {
 
         std::size_t n = 0;
 
@@ -131,10 +135,10 @@ namespace dmp {
 
         if (parseToken(it+n, TOKEN_CAST)) {
             auto e = result;
-            std::shared_ptr<Node> cast;
+            Node* cast = nullptr;
             n++;
             if (parseToken(it+n, TOKEN_IDENT)) {
-                cast = std::make_shared<Identifier>(tokens[it+n]->str, tokens[it+n]->loc);
+                cast = ast->make<Identifier>(tokens.str(it+n), tokens.loc(it+n));
                 n++;
             }
             else if (parseType(it+n)) {
@@ -142,9 +146,9 @@ namespace dmp {
                 n += nParsed;
             }
             else {
-                return error(tokens[it+n], "Failed to parse recast type");
+                return error(tokens.loc(it+n), "Failed to parse recast type");
             }
-            result = std::make_shared<BinaryExprNode>(BINARYOP_RECAST, e, cast);
+            result = ast->make<BinaryExprNode>(BINARYOP_RECAST, e, cast);
             result->loc.end = cast->loc.end;
         }
 
@@ -160,19 +164,19 @@ namespace dmp {
     bool Parser::parsePreOpUnary(std::size_t it) {
 
         std::size_t n = 0;
-        auto loc = tokens[it]->loc;
+        auto loc = tokens.loc(it);
 
         if (isUnaryOp(it)) {
-            auto op = ExprNode::unopFromToken(tokens[it]->is);
+            auto op = ExprNode::unopFromToken(tokens.kind(it));
             bool issizeop = parseToken(it, TOKEN_SIZE);
             if ((issizeop && parseType(it+1)) || parseUnaryNoRecast(it+1)) {
                 loc.end = result->loc.end;
-                result = std::make_shared<UnaryExprNode>(op, result);
+                result = ast->make<UnaryExprNode>(op, result);
                 result->loc = loc;
                 n += 1+nParsed;
             }
             else {
-                return error(tokens[it+1], "Failed to parse expression after " + tokens[it]->str);
+                return error(tokens.loc(it+1), "Failed to parse expression after " + tokens.str(it));
             }
         }
 
@@ -212,54 +216,54 @@ namespace dmp {
         if (parseToken(it, TOKEN_DOT)) {
             n++;
             if (!parseToken(it+1, TOKEN_IDENT)) {
-                return error(tokens[it+1], "Failed to parse member after \'.\'");
+                return error(tokens.loc(it+1), "Failed to parse member after \'.\'");
             }
-            auto member = std::make_shared<Identifier>(tokens[it+1]->str, tokens[it+1]->loc);
-            result = std::make_shared<BinaryExprNode>(BINARYOP_MEMBER, result, member);
+            auto member = ast->make<Identifier>(tokens.str(it+1), tokens.loc(it+1));
+            result = ast->make<BinaryExprNode>(BINARYOP_MEMBER, result, member);
         }
         else if (parseToken(it, TOKEN_DEREF)) {
-            result = std::make_shared<UnaryExprNode>(UNARYOP_DEREFERENCE, result);
+            result = ast->make<UnaryExprNode>(UNARYOP_DEREFERENCE, result);
         }
         else if (parseToken(it, TOKEN_SQUARE_OPEN)) {
             auto e = result;
             if (!parseExpr(it+1)) {
-                return error(tokens[it+1], "Failed to parse index element");
+                return error(tokens.loc(it+1), "Failed to parse index element");
             }
             n += 1+nParsed;
             if (!parseToken(it+n, TOKEN_SQUARE_CLOSE)) {
-                return error(tokens[it+n], "Missing \']\'");
+                return error(tokens.loc(it+n), "Missing \']\'");
             }
-            result = std::make_shared<BinaryExprNode>(BINARYOP_ELEMENT, e, result);
+            result = ast->make<BinaryExprNode>(BINARYOP_ELEMENT, e, result);
         }
         else if (parseToken(it, TOKEN_ROUND_OPEN)) {
             auto e = result;
-            std::vector<std::shared_ptr<Node> > argv;
+            std::vector<Node*> argv;
             n++;
             while (true) {
                 if (parseToken(it+n, TOKEN_ROUND_CLOSE)) {
                     break;
                 }
                 if (!parseExpr(it+n)) {
-                    return error(tokens[it+n], "Failed to parse argument");
+                    return error(tokens.loc(it+n), "Failed to parse argument");
                 }
                 n += nParsed;
                 argv.push_back(result);
         
                 if (parseToken(it+n, TOKEN_COMMA)) {
                     if (parseToken(it+n+1, TOKEN_ROUND_CLOSE)) {
-                        return error(tokens[it+n+1], "Cannot terminate argument list with a \',\'");
+                        return error(tokens.loc(it+n+1), "Cannot terminate argument list with a \',\'");
                     }
                     n++;
                 }
             }
-            result = std::make_shared<CallExprNode>(e, argv);
+            result = ast->make<CallExprNode>(e, argv);
         }
         else {
             return error();
         }
 
 
-        loc.end = tokens[it+n]->loc.end;
+        loc.end = tokens.loc(it+n).end;
         result->loc = loc;
         n++;
         return success(n);
@@ -285,79 +289,78 @@ namespace dmp {
     */
 
     bool Parser::parseExpr(std::size_t it) {
+        return parseMemoized(MEMO_EXPR, it, &Parser::parseExprNoMemo);
+    }
+
+    bool Parser::parseExprNoMemo(std::size_t it) {
 
         std::size_t n = 0;
 
-        std::shared_ptr<Node> lhs;
-        std::shared_ptr<Node> exp;
         if (!parseUnary(it)) {
             return error();
         }
         n += nParsed;
-        lhs = result;
-        if (!parseBinaryOperationRHS(it+n, 0, std::move(lhs))) {
+        if (!parseBinaryOperationRHS(it+n, 0, result)) {
             return error();
         }
         n += nParsed;
-        lhs = result;
-
-        if (isAssigner(it+n)) {
-            int op = ExprNode::assopFromToken(tokens[it+n]->is);
-            n++;
-            if (!parseExpr(it+n)) {
-                return error(tokens[it+n], "Failed to parse expression after " + tokens[it+n-1]->str);
-            }
-            n += nParsed;
-            exp = result;
-            result = std::make_shared<AssignExprNode>(op, lhs, exp);
-            result->loc = lhs->loc;
-            result->loc.end = exp->loc.end;
-        }
 
         return success(n);
     }
 
-    bool Parser::parseBinaryOperationRHS(std::size_t it, int prec, const std::shared_ptr<Node>& l) {
+    /*
+
+    Precedence climbing (Pratt) loop over the binary and assignment operators that follow an operand.
+    Operators binding at least as tightly as 'prec' are folded into the left operand. The right operand
+    of an operator extends over all the operators that bind more tightly than it, or equally tightly if it is
+    right-associative. Precedence and associativity are looked up in the operator table of ExprNode. 
+
+    */
+
+    bool Parser::parseBinaryOperationRHS(std::size_t it, int prec, Node* l) {
 
         std::size_t n = 0;
-        std::shared_ptr<Node> lhs = l;
+        Node* lhs = l;
         auto loc = lhs->loc;
 
-        while (true) {
-
-            int current_op = tokens[it+n]->is;
-            int current_prec = isBinaryMathOp(it+n) ? ExprNode::precedence(current_op) : -1;
+        while (isBinaryMathOp(it+n) || isAssigner(it+n)) {
 
+            int current_op = tokens.kind(it+n);
+            int current_prec = ExprNode::precedence(current_op);
             if (current_prec < prec) {
-                result = lhs;
-                return success(n);
+                break;
             }
+            auto err = ExprNode::isAssop(current_op) ? "Failed to parse expression after " + tokens.str(it+n) : "Failed to parse expression";
             n++;
+            auto start = it+n;
 
             if (!parseUnary(it+n)) {
-                return error(tokens[it+n], "Failed to parse expression");
+                return error(tokens.loc(it+n), err);
             }
             n += nParsed;
             auto rhs = result;
 
-            int next_op = tokens[it+n]->is;
-            int next_prec = ExprNode::precedence(next_op);
-            if (next_prec <= 0) {
-                next_prec = -1;
-            }
-
-            if (next_prec > current_prec) {
-                if (!parseBinaryOperationRHS(it+n, current_prec+1, std::move(rhs))) {
-                    return error(tokens[it+n], "Failed to parse expression");
+            int next_prec = current_prec + (ExprNode::associativity(current_op) == ASSOC_LEFT ? 1 : 0);
+            if ((isBinaryMathOp(it+n) || isAssigner(it+n)) && ExprNode::precedence(tokens.kind(it+n)) >= next_prec) {
+                if (!parseBinaryOperationRHS(it+n, next_prec, rhs)) {
+                    return error(tokens.loc(ExprNode::isAssop(current_op) ? start : it+n), err);
                 }
                 n += nParsed;
                 rhs = result;
             }
 
             loc.end = rhs->loc.end;
-            lhs = std::make_shared<BinaryExprNode>(ExprNode::binopFromToken(current_op), lhs, rhs);
+            if (ExprNode::isAssop(current_op)) {
+                lhs = ast->make<AssignExprNode>(ExprNode::assopFromToken(current_op), lhs, rhs);
+            }
+            else {
+                lhs = ast->make<BinaryExprNode>(ExprNode::binopFromToken(current_op), lhs, rhs);
+            }
             lhs->loc = loc;
         }
+
+        result = lhs;
+        return success(n);
     }
 
 }
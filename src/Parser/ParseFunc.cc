@@ -15,14 +15,14 @@ namespace dmp {
     bool Parser::parseFunc(std::size_t it) {
 
         if (parseToken(it, TOKEN_CURLY_OPEN) && parseToken(it+1, TOKEN_CURLY_CLOSE)) {
-            auto nullinit = std::make_shared<NullInit>(true);
-            nullinit->loc = tokens[it]->loc;
-            nullinit->loc.end = tokens[it+1]->loc.end;
+            auto nullinit = ast->make<NullInit>(true);
+            nullinit->loc = tokens.loc(it);
+            nullinit->loc.end = tokens.loc(it+1).end;
             result = nullinit;
             return success(2);
         }
 
-        std::shared_ptr<BlockNode> func = std::make_shared<BlockNode>(BLOCK_FUNCTION);
+        BlockNode* func = ast->make<BlockNode>(BLOCK_FUNCTION);
         if (parseBlock(it, func)) {
             result = func;
             return true;       
@@ -41,21 +41,21 @@ namespace dmp {
 
     */
 
-    bool Parser::parseBlock(std::size_t it, const std::shared_ptr<BlockNode>& b) {
+    bool Parser::parseBlock(std::size_t it, BlockNode* b) {
 
         std::size_t n = 0;
 
         if (!parseToken(it, TOKEN_CURLY_OPEN)) {
             return error();
         }
-        b->loc = tokens[it]->loc;
+        b->loc = tokens.loc(it);
         n++;
         std::size_t count = 0;
         while (true) {
-            std::shared_ptr<Statement> stmt;
-            auto loc = tokens[it+n]->loc;
+            Statement* stmt = nullptr;
+            auto loc = tokens.loc(it+n);
             if (parseToken(it+n, TOKEN_CURLY_CLOSE)) {
-                b->loc.end = tokens[it+n]->loc.end;
+                b->loc.end = tokens.loc(it+n).end;
                 n++;
                 break;
             }
@@ -63,26 +63,26 @@ namespace dmp {
                 n++;
             }
             else if (parseStatement(it+n, b)) {
-                stmt = std::static_pointer_cast<Statement>(result);
+                stmt = static_cast<Statement*>(result);
                 n += nParsed;
                 if (!parseToken(it+n, TOKEN_SEMICOLON)) {
-                    return error(tokens[it+n], "Expect \';\' at the end of statement");
+                    return error(tokens.loc(it+n), "Expect \';\' at the end of statement");
                 }
                 n++;
             }
             else if (parseIf(it+n, b) || parseLoop(it+n, b)) {
-                stmt = std::static_pointer_cast<Statement>(result);
+                stmt = static_cast<Statement*>(result);
                 n += nParsed;
             }
             else {
                 if (count == 0) {
                     return error();
                 }
-                return error(tokens[it+n], "Failed to parse statement");
+                return error(tokens.loc(it+n), "Failed to parse statement");
             }
 
             stmt->loc = loc;
-            stmt->loc.end = tokens[it+n-1]->loc.end;
+            stmt->loc.end = tokens.loc(it+n-1).end;
             b->body.push_back(stmt);
             count++;
         }
@@ -100,26 +100,26 @@ namespace dmp {
 
     */
 
-    bool Parser::parseStatement(std::size_t it, const std::shared_ptr<BlockNode>& b) {
+    bool Parser::parseStatement(std::size_t it, BlockNode* b) {
         
         std::size_t n = 0;
 
         if (parseToken(it, TOKEN_CONTINUE)) {
             n++;
-            result = std::make_shared<ContinueStatement>();
+            result = ast->make<ContinueStatement>();
         }
         else if (parseToken(it, TOKEN_BREAK)) {
             n++;
-            result = std::make_shared<BreakStatement>();
+            result = ast->make<BreakStatement>();
         }
         else if (parseToken(it, TOKEN_RETURN)) {
             n++;
-            std::shared_ptr<Node> retval;
+            Node* retval = nullptr;
             if (parseExpr(it+n)) {
                 n += nParsed;
                 retval = result;
             }
-            result = std::make_shared<ReturnStatement>(retval);
+            result = ast->make<ReturnStatement>(retval);
         }
         else if (parseLocalVarDef(it, b)) {
             n += nParsed;
@@ -129,14 +129,14 @@ namespace dmp {
         }
         else if (parseExpr(it)) {
             n += nParsed;
-            auto exp = static_cast<ExprNode*>(result.get());
+            auto exp = static_cast<ExprNode*>(result);
             if (exp->is == EXPR_ASSIGN) {
-                auto assign = std::static_pointer_cast<AssignExprNode>(result);
-                result = std::make_shared<AssignStatement>(assign);
+                auto assign = static_cast<AssignExprNode*>(result);
+                result = ast->make<AssignStatement>(assign);
             }
             else if (exp->is == EXPR_CALL) {
-                auto call = std::static_pointer_cast<CallExprNode>(result);
-                result = std::make_shared<CallStatement>(call);
+                auto call = static_cast<CallExprNode*>(result);
+                result = ast->make<CallStatement>(call);
             }
             else {
                 return error(result, "Statement expression not an assignment or function call");
@@ -160,20 +160,20 @@ namespace dmp {
 
     */
 
-    bool Parser::parseIf(std::size_t it, const std::shared_ptr<BlockNode>& b) {
+    bool Parser::parseIf(std::size_t it, BlockNode* b) {
         
         std::size_t n = 0;
 
         bool if_done = false;
         //auto ifblock = std::make_shared<IfBlockNode>(b);
-        auto ifblock = std::make_shared<BlockNode>(BLOCK_IF, b);
+        auto ifblock = ast->make<BlockNode>(BLOCK_IF, b);
         while (true) {
-            auto loc = tokens[it+n]->loc;
-            std::shared_ptr<Node> ifcond;
+            auto loc = tokens.loc(it+n);
+            Node* ifcond = nullptr;
             if (parseToken(it+n, TOKEN_IF)) {
                 n++;
                 if (!parseExpr(it+n)) {
-                    return error(tokens[it+n], "Failed to parse \'if\' condition expression");
+                    return error(tokens.loc(it+n), "Failed to parse \'if\' condition expression");
                 }
                 n += nParsed;
                 ifcond = result;
@@ -182,10 +182,10 @@ namespace dmp {
             if (!if_done) {
                 return error();
             }
-            auto cond_block = std::make_shared<CondBlockNode>(ifblock);
+            auto cond_block = ast->make<CondBlockNode>(ifblock);
             cond_block->condition = ifcond;
             if (!parseBlock(it+n, cond_block)) {
-                return error(tokens[it+n], "Failed to parse \'if\' block");
+                return error(tokens.loc(it+n), "Failed to parse \'if\' block");
             }
             cond_block->loc.start = loc.start;
             ifblock->body.push_back(cond_block);
@@ -211,14 +211,14 @@ namespace dmp {
 
     */
 
-    bool Parser::parseLoop(std::size_t it, const std::shared_ptr<BlockNode>& b) {
+    bool Parser::parseLoop(std::size_t it, BlockNode* b) {
         
         std::size_t n = 0;
        
-        auto loop = std::make_shared<BlockNode>(BLOCK_LOOP, b);
-        auto cond_block = std::make_shared<CondBlockNode>(loop);
-        std::shared_ptr<Statement> init;
-        std::shared_ptr<Statement> update;
+        auto loop = ast->make<BlockNode>(BLOCK_LOOP, b);
+        auto cond_block = ast->make<CondBlockNode>(loop);
+        Statement* init = nullptr;
+        Statement* update = nullptr;
 
         if (!parseToken(it, TOKEN_LOOP)  && 
             !parseToken(it, TOKEN_WHILE) &&
@@ -230,28 +230,28 @@ namespace dmp {
 
 	if (parseToken(it, TOKEN_LOOP)) {
             if (!parseToken(it+n, TOKEN_CURLY_OPEN)) {
-                return error(tokens[it+n], "Expect start of loop block after \'loop\'");
+                return error(tokens.loc(it+n), "Expect start of loop block after \'loop\'");
             }
         }
 	else if (parseToken(it, TOKEN_WHILE)) {
             if (!parseExpr(it+n)) {
-                return error(tokens[it+n], "Failed to parse the while loop termination condition");
+                return error(tokens.loc(it+n), "Failed to parse the while loop termination condition");
             }
             cond_block->condition = result;
             n += nParsed;
             if (!parseToken(it+n, TOKEN_CURLY_OPEN)) {
-                return error(tokens[it+n], "Expect start of loop block after while loop termination condition");
+                return error(tokens.loc(it+n), "Expect start of loop block after while loop termination condition");
             }
         }
         else {
             if (parseStatement(it+n, loop)) {
-                init = std::static_pointer_cast<Statement>(result);
-                init->loc = tokens[it+n]->loc;
+                init = static_cast<Statement*>(result);
+                init->loc = tokens.loc(it+n);
                 n += nParsed;
-                init->loc.end = tokens[it+n-1]->loc.end;
+                init->loc.end = tokens.loc(it+n-1).end;
             }
             if (!parseToken(it+n, TOKEN_SEMICOLON)) {
-                return error(tokens[it+n], "Failed to parse the for loop initialization statement");
+                return error(tokens.loc(it+n), "Failed to parse the for loop initialization statement");
             }
             n++;
 
@@ -260,23 +260,23 @@ namespace dmp {
 		n += nParsed;
             }
             if (!parseToken(it+n, TOKEN_SEMICOLON)) {
-                return error(tokens[it+n], "Failed to parse the for loop termination condition");
+                return error(tokens.loc(it+n), "Failed to parse the for loop termination condition");
             }
             n++;
 
             if (parseStatement(it+n, loop)) {
-                update = std::static_pointer_cast<Statement>(result);
-                update->loc = tokens[it+n]->loc;
+                update = static_cast<Statement*>(result);
+                update->loc = tokens.loc(it+n);
                 n += nParsed;
-                update->loc.end = tokens[it+n-1]->loc.end;
+                update->loc.end = tokens.loc(it+n-1).end;
             }
             if (!parseToken(it+n, TOKEN_CURLY_OPEN)) {
-                return error(tokens[it+n], "Failed to parse the for loop update statement");
+                return error(tokens.loc(it+n), "Failed to parse the for loop update statement");
             }
         }
 
         if (!parseBlock(it+n, cond_block)) {
-            return error(tokens[it+n], "Failed to parse the loop block");
+            return error(tokens.loc(it+n), "Failed to parse the loop block");
         }
         n += nParsed;
 
@@ -292,31 +292,40 @@ namespace dmp {
     /*
 
     LOCAL_VAR_DEF : TOKEN_IDENT ':=' EXPR |
-                    TOKEN_IDENT ':=' (TOKEN_IDENT | TYPE) INITIALIZER
+                    TOKEN_IDENT ':=' [ALIGNMENT] (TOKEN_IDENT | TYPE) INITIALIZER
 
     */
 
-    bool Parser::parseLocalVarDef(std::size_t it, const std::shared_ptr<BlockNode>& b) {
+    bool Parser::parseLocalVarDef(std::size_t it, BlockNode* b) {
  
         std::size_t n = 0;
 
-        std::shared_ptr<Identifier> name;
-        std::shared_ptr<Node> type;
-        std::shared_ptr<Node> def;
+        Identifier* name = nullptr;
+        Node* type = nullptr;
+        Node* def = nullptr;
+        Node* align = nullptr;
 
         if (!parseToken(it, TOKEN_IDENT) || !parseToken(it+1, TOKEN_DEFINE)) {
             return error();
         }
-        const auto& nm = tokens[it]->str;
+        auto nm = tokens.str(it);
         if (!isAvailableLocally(it, b)) {
             return error();
         }
-        name = std::make_shared<Identifier>(nm, tokens[it]->loc);
+        name = ast->make<Identifier>(nm, tokens.loc(it));
         n += 2;
 
-        if (!parseExpr(it+n) || parseToken(it+n+nParsed, TOKEN_CURLY_OPEN)) {
+        if (parseToken(it+n, TOKEN_ALIGN)) {
+            if (!parseAlignment(it+n)) {
+                return error();
+            }
+            align = result;
+            n += nParsed;
+        }
+
+        if (align || !parseExpr(it+n) || parseToken(it+n+nParsed, TOKEN_CURLY_OPEN)) {
             if (parseToken(it+n, TOKEN_IDENT)) {
-                type = std::make_shared<Identifier>(tokens[it+n]->str, tokens[it+n]->loc);
+                type = ast->make<Identifier>(tokens.str(it+n), tokens.loc(it+n));
                 n++;
             }
             else if (parseType(it+n)) {
@@ -324,18 +333,18 @@ namespace dmp {
                 n += nParsed;
             }
             else {
-                return error(tokens[it+n], "Unable to parse the definition of local variable " + nm);
+                return error(tokens.loc(it+n), "Unable to parse the definition of local variable " + nm);
             }
 
             if (!parseInit(it+n)) {
-                return error(tokens[it+n], "Unable to parse initializer of local variable " + nm);
+                return error(tokens.loc(it+n), "Unable to parse initializer of local variable " + nm);
             }
         }
 
         n += nParsed;
         def = result;
-        auto vdef = std::make_shared<DefineStatement>(STORAGE_LOCAL, name, type, def);
-        b->symbols[nm] = vdef->name;
+        auto vdef = ast->make<DefineStatement>(STORAGE_LOCAL, name, type, def, align);
+        b->symbols[name->id] = vdef->name;
 
         result = vdef;
         return success(n);
@@ -347,12 +356,12 @@ namespace dmp {
 
     */
 
-    bool Parser::parseLocalRefDef(std::size_t it, const std::shared_ptr<BlockNode>& b) {
+    bool Parser::parseLocalRefDef(std::size_t it, BlockNode* b) {
 
         std::size_t n = 0;
 
-        std::shared_ptr<Identifier> name;
-        std::shared_ptr<Node> def;
+        Identifier* name = nullptr;
+        Node* def = nullptr;
 
         if (!parseToken(it, TOKEN_DEREF)) {
             return error();
@@ -360,40 +369,41 @@ namespace dmp {
         n++;
         if (!parseToken(it+n, TOKEN_IDENT) || !parseToken(it+n+1, TOKEN_DEFINE)) {
             if (!parseToken(it+n, TOKEN_IDENT)) {
-                return error(tokens[it+n], "Expect identifier after \'$\'");
+                return error(tokens.loc(it+n), "Expect identifier after \'$\'");
             }
             else {
-                return error(tokens[it+n], "Expect \':=\' after " + tokens[it+n]->str);
+                return error(tokens.loc(it+n), "Expect \':=\' after " + tokens.str(it+n));
             }
         }
-        const auto& nm = tokens[it+n]->str;
+        auto nm = tokens.str(it+n);
         if (!isAvailableLocally(it+n, b)) {
             return error();
         }
-        name = std::make_shared<Identifier>(nm, tokens[it+n]->loc);
+        name = ast->make<Identifier>(nm, tokens.loc(it+n));
         n += 2;
 
         if (!parseExpr(it+n)) {
-            return error(tokens[it+n], "Unable to parse referee expression for " + nm);
+            return error(tokens.loc(it+n), "Unable to parse referee expression for " + nm);
         }
         n += nParsed;
         def = result;
 
-        auto vdef = std::make_shared<DefineStatement>(STORAGE_REFERENCE, name, nullptr, def);
-        b->symbols[nm] = vdef->name;
+        auto vdef = ast->make<DefineStatement>(STORAGE_REFERENCE, name, nullptr, def);
+        b->symbols[name->id] = vdef->name;
 
         result = vdef;
         return success(n);
     }
 
-    bool Parser::isAvailableLocally(std::size_t it, const std::shared_ptr<BlockNode>& b) {
+    bool Parser::isAvailableLocally(std::size_t it, BlockNode* b) {
 
-        const auto& nm = tokens[it]->str;
-        if (b->symbols.find(nm) != b->symbols.end()) {
+        auto nm = tokens.str(it);
+        auto sym = b->symbols.find(TheInterner->intern(nm));
+        if (sym != b->symbols.end()) {
             std::stringstream err;
             err << "Redefinition of " << nm << ". " << "Previous occurence at ";
-            err << b->symbols[nm]->loc.filename(input) << ":" << b->symbols[nm]->loc.start.line;
-            return error(tokens[it], err.str());
+            err << sym->second->loc.filename(input) << ":" << sym->second->loc.start.line;
+            return error(tokens.loc(it), err.str());
         }
 
         return true;
@@ -25,7 +25,7 @@ namespace dmp {
                 if (iev.size() == 0) {
                     return error();
                 }
-                return error(tokens[it+n], "Failed to parse untagged rvalue in initializer set");
+                return error(tokens.loc(it+n), "Failed to parse untagged rvalue in initializer set");
             }
             n += nParsed;
             iev.push_back(InitElement(result));
@@ -34,7 +34,7 @@ namespace dmp {
             }
             n++;
         }
-        result = std::make_shared<Initializer>(iev);
+        result = ast->make<Initializer>(iev);
         return success(n);
     }
 
@@ -57,20 +57,20 @@ namespace dmp {
 
         std::vector<InitElement> iev;
         while (true) {
-            std::shared_ptr<Node> tag;
-            std::shared_ptr<Node> rv;
+            Node* tag = nullptr;
+            Node* rv = nullptr;
             bool indexed = false;
-            auto loc = tokens[it+n]->loc;
+            auto loc = tokens.loc(it+n);
 
             if (parseToken(it+n, TOKEN_SQUARE_OPEN)) {
                 n++;
                 if (!parseExpr(it+n)) {
-                    return error(tokens[it+n], "Failed to parse index of rvalue in initializer set");
+                    return error(tokens.loc(it+n), "Failed to parse index of rvalue in initializer set");
                 }
                 n += nParsed;
                 tag = result;
                 if (!parseToken(it+n, TOKEN_SQUARE_OPEN)) {
-                    return error(tokens[it+n], "Expect \']\' to terminate the index in initializer");
+                    return error(tokens.loc(it+n), "Expect \']\' to terminate the index in initializer");
                 }
                 n++;
                 indexed = true;
@@ -78,25 +78,25 @@ namespace dmp {
             else if (parseToken(it+n, TOKEN_DOT)) {
                 n++;
                 if (!parseToken(it+n, TOKEN_IDENT)) {
-                    return error(tokens[it+n], "Failed to parse member tag in initializer set");
+                    return error(tokens.loc(it+n), "Failed to parse member tag in initializer set");
                 }
-                tag = std::make_shared<Identifier>(tokens[it+n]->str, tokens[it+n]->loc);
+                tag = ast->make<Identifier>(tokens.str(it+n), tokens.loc(it+n));
                 n++;
             }
             else {
                 if (iev.size() == 0) {
                     return error();
                 }
-                return error(tokens[it+n], "Failed to parse the tag in initializer set");
+                return error(tokens.loc(it+n), "Failed to parse the tag in initializer set");
             }
 
             if (!parseToken(it+n, TOKEN_ASSIGN)) {
-                return error(tokens[it+n], "Expect \'=\' after rvalue tag in initializer set");
+                return error(tokens.loc(it+n), "Expect \'=\' after rvalue tag in initializer set");
             }
             n++;
 
             if (!parseExpr(it+n) && !parseInit(it+n)) {
-                return error(tokens[it+n], "Failed to parse tagged rvalue in initializer set");
+                return error(tokens.loc(it+n), "Failed to parse tagged rvalue in initializer set");
             }
             n += nParsed;
             rv = result;
@@ -112,7 +112,7 @@ namespace dmp {
             n++;
         }
 
-        result = std::make_shared<Initializer>(iev);
+        result = ast->make<Initializer>(iev);
         return success(n);
     }
 
@@ -134,11 +134,11 @@ namespace dmp {
         n++;
 
         if (parseToken(it+n, TOKEN_CURLY_CLOSE)) {
-            result = std::make_shared<NullInit>(true);
+            result = ast->make<NullInit>(true);
             n++;
         }
         else if (parseToken(it+n, TOKEN_COMPLEMENT) && parseToken(it+n+1, TOKEN_CURLY_CLOSE)) {
-            result = std::make_shared<NullInit>(false);
+            result = ast->make<NullInit>(false);
             n += 2;
         }
         else if (parseUntaggedInitSet(it+n) || 
@@ -146,7 +146,7 @@ namespace dmp {
         {
             n += nParsed;
             if (!parseToken(it+n, TOKEN_CURLY_CLOSE)) {
-                return error(tokens[it+n], "Expect \'}\' at the end of initializer set");
+                return error(tokens.loc(it+n), "Expect \'}\' at the end of initializer set");
             }
             n++;
         } 
@@ -154,8 +154,8 @@ namespace dmp {
             return error();
         }
 
-        auto loc = tokens[it]->loc;
-        loc.end = tokens[it+n-1]->loc.end;
+        auto loc = tokens.loc(it);
+        loc.end = tokens.loc(it+n-1).end;
         result->loc = loc;
         return success(n);
     }
@@ -1,4 +1,5 @@
 #include <sstream>
+#include <IO/InputFile.h>
 #include <Parser/Parser.h>
 #include <Lexer/TokenID.h>
 
@@ -19,25 +20,27 @@ namespace dmp {
 
     bool Parser::parseProg(std::size_t it) {
 
-        if (parseToken(it, TOKEN_EOF)) {
-            return success(0);
-        }
+        while (!parseToken(it, TOKEN_EOF)) {
+
+            if (!parseEmpty(it) &&
+                !parseInclude(it) &&
+                !parseRepresentation(it) &&
+                !parseDeclaration(it) &&
+                !parseDefinition(it) &&
+                !parseRefDef(it))
+            {
+                if (hasErrors()) {
+                    return error();
+                }
+                return error(tokens.loc(it), "Unable to parse unit");
+            }
 
-        if (parseEmpty(it) ||
-            parseInclude(it) ||
-            parseRepresentation(it) ||
-            parseDeclaration(it) ||
-            parseDefinition(it) ||
-            parseRefDef(it))
-        {
-            tokens.erase(tokens.begin()+it, tokens.begin()+it+nParsed);
-            return parseProg(it);
+            it += nParsed;
+            tokens.consume(it);
+            memo.clear();
         }
 
-        if (hasErrors()) {
-            return error();
-        }
-        return error(tokens[it], "Unable to parse unit");
+        return success(0);
 
     }
 
@@ -71,10 +74,10 @@ namespace dmp {
         }
         n++;
         if (!parseToken(it+n, TOKEN_FILENAME)) {
-            return error(tokens[it+n], "Expect a valid filename after \'include\'");
+            return error(tokens.loc(it+n), "Expect a valid filename after \'include\'");
         }
 
-        auto filename = tokens[it+n]->str;
+        auto filename = tokens.str(it+n);
         while (filename[0] == ' '  ||
                filename[0] == '\f' ||
                filename[0] == '\n' ||
@@ -94,26 +97,99 @@ namespace dmp {
             filename.erase(filename.end()-1);
         }
 
+        if (!include(filename, tokens.loc(it+n))) {
+            return error();
+        }
+        if (!units.empty()) {
+            units.back().entries.emplace_back(filename, tokens.loc(it+n));
+        }
+
+        n++;
+        return success(n);
+
+    }
+
+    bool Parser::include(const std::string& filename, const Location& loc) {
+
         if (input->isActive(filename)) {
-            return error(tokens[it+n], "Circular inclusion of " + filename);
+            return error(loc, "Circular inclusion of " + filename);
         }
         if (input->isProcessed(filename)) {
-            return success(n);
+            return true;
         }
         input->set(filename);
         if (!input->isValid()) {
-            return error(tokens[it+n], "Unable to open file " + filename);
+            return error(loc, "Unable to open file " + filename);
         }
-        if (!run()) {
+        if (!(cache ? includeCached() : run())) {
             return error();
         }
         input->reset();
+        return true;
 
-        n++;
-        return success(n);
+    }
+
+    bool Parser::includeCached() {
+
+        auto source = input->currentInputFile->buffer->getBuffer();
+        auto index = input->currentInputFile->index;
+        auto path = input->getFilePath(index);
+
+        auto blob = cache->load(path, source);
+        if (blob) {
+            IncludeUnit unit;
+            if (unit.deserialize(IncludeCache::contents(*blob), ast, index)) {
+                return replay(unit);
+            }
+        }
+
+        units.emplace_back();
+        bool status = run();
+        if (status) {
+            cache->store(path, source, units.back().serialize(index));
+        }
+        units.pop_back();
+        return status;
 
     }
 
+    bool Parser::replay(const IncludeUnit& unit) {
+
+        for (const auto& entry : unit.entries) {
+            if (entry.is == ENTRY_INCLUDE) {
+                if (!include(entry.filename, entry.loc)) {
+                    return error();
+                }
+                continue;
+            }
+
+            Identifier* name = nullptr;
+            if (entry.is == ENTRY_DEFINITION) {
+                name = static_cast<DefineStatement*>(entry.node)->name;
+            }
+            else {
+                name = static_cast<NameNode*>(entry.node)->name;
+            }
+            if (!isAvailable(name->name, name->loc)) {
+                return error();
+            }
+
+            switch (entry.is) {
+                case ENTRY_REPRESENTATION : ast->representations[name->id] = static_cast<NameNode*>(entry.node); break;
+                case ENTRY_DECLARATION    : ast->declarations[name->id] = static_cast<NameNode*>(entry.node); break;
+                case ENTRY_DEFINITION     : ast->definitions[name->id] = static_cast<DefineStatement*>(entry.node); break;
+            }
+        }
+        return true;
+
+    }
+
+    void Parser::record(uint16_t is, Node* node) {
+        if (!units.empty()) {
+            units.back().entries.emplace_back(is, node);
+        }
+    }
+
     /*
 
     REPRESENTATION : TOKEN_IDENT '::' (TYPE | EXPR) [';']
@@ -128,21 +204,22 @@ namespace dmp {
             return error();
         }
 
-        std::shared_ptr<Identifier> name;
+        Identifier* name = nullptr;
 
         if (!isAvailable(it)) {
             return error();
         }
-        const auto& nm = tokens[it]->str;
-        name = std::make_shared<Identifier>(nm, tokens[it]->loc);
+        auto nm = tokens.str(it);
+        name = ast->make<Identifier>(nm, tokens.loc(it));
         n += 2;
 
         if (parseType(it+n) || parseExpr(it+n)) {
-            ast->representations[nm] = std::make_shared<NameNode>(name, result);
+            ast->representations[name->id] = ast->make<NameNode>(name, result);
+            record(ENTRY_REPRESENTATION, ast->representations[name->id]);
             n += nParsed;
         }
         else {
-            return error(tokens[it+n], "Unable to parse the definition of representation " + nm);
+            return error(tokens.loc(it+n), "Unable to parse the definition of representation " + nm);
         }
 
         if (parseToken(it+n, TOKEN_SEMICOLON)) {
@@ -165,18 +242,18 @@ namespace dmp {
             return error();
         }
 
-        std::shared_ptr<Identifier> name;
-        std::shared_ptr<Node> type;
+        Identifier* name = nullptr;
+        Node* type = nullptr;
 
         if (!isAvailable(it)) {
             return error();
         }
-        const auto& nm = tokens[it]->str;
-        name = std::make_shared<Identifier>(nm, tokens[it]->loc);
+        auto nm = tokens.str(it);
+        name = ast->make<Identifier>(nm, tokens.loc(it));
         n += 2;
 
         if (parseToken(it+n, TOKEN_IDENT)) {
-            type = std::make_shared<Identifier>(tokens[it+n]->str, tokens[it+n]->loc);
+            type = ast->make<Identifier>(tokens.str(it+n), tokens.loc(it+n));
             n++;
         }
         else if (parseType(it+n)) {
@@ -184,10 +261,11 @@ namespace dmp {
             n += nParsed;
         }
         else {
-            return error(tokens[it+n], "Unable to parse declaration type");
+            return error(tokens.loc(it+n), "Unable to parse declaration type");
         }
 
-        ast->declarations[nm] = std::make_shared<NameNode>(name, type);
+        ast->declarations[name->id] = ast->make<NameNode>(name, type);
+        record(ENTRY_DECLARATION, ast->declarations[name->id]);
 
         if (parseToken(it+n, TOKEN_SEMICOLON)) {
             n++;
@@ -197,7 +275,7 @@ namespace dmp {
 
     /*
 
-    DEFINITION : ['extern'] TOKEN_IDENT ':=' (TOKEN_IDENT | TYPE) (INITIALIZER | FUNCTION_BLOCK) [';'] |
+    DEFINITION : ['extern'] TOKEN_IDENT ':=' [ALIGNMENT] (TOKEN_IDENT | TYPE) (INITIALIZER | FUNCTION_BLOCK) [';'] |
                  ['extern'] TOKEN_IDENT ':=' EXPR [';']
 
     */
@@ -207,9 +285,10 @@ namespace dmp {
         std::size_t n = 0;
 
         uint16_t storage = STORAGE_INTERNAL;
-        std::shared_ptr<Identifier> name;
-        std::shared_ptr<Node> type;
-        std::shared_ptr<Node> def;
+        Identifier* name = nullptr;
+        Node* type = nullptr;
+        Node* def = nullptr;
+        Node* align = nullptr;
         bool isMain = false;
 
         if (parseToken(it, TOKEN_EXTERN)) {
@@ -218,26 +297,34 @@ namespace dmp {
         }
 
         if (!parseToken(it+n, TOKEN_IDENT) && !parseToken(it+n, TOKEN_MAIN)) {
-            return (storage == STORAGE_EXTERNAL ? error(tokens[it+n], "Expect global name after \'extern\'") : error());
+            return (storage == STORAGE_EXTERNAL ? error(tokens.loc(it+n), "Expect global name after \'extern\'") : error());
         }
         if (parseToken(it+n, TOKEN_MAIN)) {
             isMain = true;
         }
-        const auto& nm = tokens[it+n]->str;
-        name = std::make_shared<Identifier>(nm, tokens[it+n]->loc);
+        auto nm = tokens.str(it+n);
+        name = ast->make<Identifier>(nm, tokens.loc(it+n));
         n++;
 
         if (!parseToken(it+n, TOKEN_DEFINE)) {
-            return (storage == STORAGE_INTERNAL ? error() : error(tokens[it+n], "Expect \':=\' after " + nm + " in global definition"));
+            return (storage == STORAGE_INTERNAL ? error() : error(tokens.loc(it+n), "Expect \':=\' after " + nm + " in global definition"));
         }
         if (!isAvailable(it+n-1)) {
             return error();
         }
         n++;
 
-        if (!parseExpr(it+n) || parseToken(it+n+nParsed, TOKEN_CURLY_OPEN)) {
+        if (parseToken(it+n, TOKEN_ALIGN)) {
+            if (!parseAlignment(it+n)) {
+                return error();
+            }
+            align = result;
+            n += nParsed;
+        }
+
+        if (align || !parseExpr(it+n) || parseToken(it+n+nParsed, TOKEN_CURLY_OPEN)) {
             if (parseToken(it+n, TOKEN_IDENT)) {
-                type = std::make_shared<Identifier>(tokens[it+n]->str, tokens[it+n]->loc);
+                type = ast->make<Identifier>(tokens.str(it+n), tokens.loc(it+n));
                 n++;
             }
             else if (parseType(it+n)) {
@@ -245,24 +332,25 @@ namespace dmp {
                 n += nParsed;
             }
             else {
-                return error(tokens[it+n], "Unable to parse the definition of " + nm);
+                return error(tokens.loc(it+n), "Unable to parse the definition of " + nm);
             }
 
             if (parseInit(it+n)) {
                 if (isMain) {
-                    return error(tokens[it+n], "\'main\' can only be a function");
+                    return error(tokens.loc(it+n), "\'main\' can only be a function");
                 }
             }
             else if (parseFunc(it+n)) {
             }
             else {
-                return error(tokens[it+n], "Unable to parse the definition of " + nm);
+                return error(tokens.loc(it+n), "Unable to parse the definition of " + nm);
             }
         }
 
         n += nParsed;
         def = result;
-        ast->definitions[nm] = std::make_shared<DefineStatement>(storage, name, type, def);
+        ast->definitions[name->id] = ast->make<DefineStatement>(storage, name, type, def, align);
+        record(ENTRY_DEFINITION, ast->definitions[name->id]);
 
         if (parseToken(it+n, TOKEN_SEMICOLON)) {
             n++;
@@ -281,9 +369,9 @@ namespace dmp {
         std::size_t n = 0;
 
         uint16_t storage = STORAGE_REFERENCE;
-        std::shared_ptr<Identifier> name;
-        std::shared_ptr<Node> type;
-        std::shared_ptr<Node> def;
+        Identifier* name = nullptr;
+        Node* type = nullptr;
+        Node* def = nullptr;
 
         if (!parseToken(it, TOKEN_DEREF)) {
             return error();
@@ -291,14 +379,14 @@ namespace dmp {
         n++;
 
         if (!parseToken(it+n, TOKEN_IDENT)) {
-            return error(tokens[it+n], "Expect identifier after \'@\'");
+            return error(tokens.loc(it+n), "Expect identifier after \'@\'");
         }
-        const auto& nm = tokens[it+n]->str;
-        name = std::make_shared<Identifier>(nm, tokens[it+n]->loc);
+        auto nm = tokens.str(it+n);
+        name = ast->make<Identifier>(nm, tokens.loc(it+n));
         n++;
 
         if (!parseToken(it+n, TOKEN_DEFINE)) {
-            return error(tokens[it+n], "Expect \':=\' after " + nm + " in global reference definition");
+            return error(tokens.loc(it+n), "Expect \':=\' after " + nm + " in global reference definition");
         }
         if (!isAvailable(it+n-1)) {
             return error();
@@ -306,11 +394,12 @@ namespace dmp {
         n++;
 
         if (!parseExpr(it+n)) {
-            return error(tokens[it+n], "Unable to parse the referee of global reference " + nm);
+            return error(tokens.loc(it+n), "Unable to parse the referee of global reference " + nm);
         }
         n += nParsed;
         def = result;
-        ast->definitions[nm] = std::make_shared<DefineStatement>(storage, name, type, def);
+        ast->definitions[name->id] = ast->make<DefineStatement>(storage, name, type, def);
+        record(ENTRY_DEFINITION, ast->definitions[name->id]);
 
         if (parseToken(it+n, TOKEN_SEMICOLON)) {
             n++;
@@ -319,23 +408,27 @@ namespace dmp {
     }
 
     bool Parser::isAvailable(std::size_t it) {
+        return isAvailable(tokens.str(it), tokens.loc(it));
+    }
+
+    bool Parser::isAvailable(const std::string& nm, const Location& loc) {
 
-        std::shared_ptr<Identifier> prev;
-        const auto& nm = tokens[it]->str;
-        if (ast->representations.find(nm) != ast->representations.end()) {
-            prev = ast->representations[nm]->name;
+        Identifier* prev = nullptr;
+        auto id = TheInterner->intern(nm);
+        if (ast->representations.contains(id)) {
+            prev = ast->representations[id]->name;
         }
-        else if (ast->declarations.find(nm) != ast->declarations.end()) {
-            prev = ast->declarations[nm]->name;
+        else if (ast->declarations.contains(id)) {
+            prev = ast->declarations[id]->name;
         }
-        else if (ast->definitions.find(nm) != ast->definitions.end()) {
-            prev = ast->definitions[nm]->name;
+        else if (ast->definitions.contains(id)) {
+            prev = ast->definitions[id]->name;
         }
         if (prev) {
             std::stringstream err;
             err << "Redefinition of " << nm << ". ";
             err << "Previous occurence at " << prev->loc.filename(input) << ":" << prev->loc.start.line;
-            return error(tokens[it], err.str());
+            return error(loc, err.str());
         }
         return true;
     }
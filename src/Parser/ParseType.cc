@@ -11,6 +11,10 @@ namespace dmp {
     */
 
     bool Parser::parseType(std::size_t it) {
+        return parseMemoized(MEMO_TYPE, it, &Parser::parseTypeNoMemo);
+    }
+
+    bool Parser::parseTypeNoMemo(std::size_t it) {
 
         if (parseDataType(it) ||
             parseFuncType(it))
@@ -75,8 +79,8 @@ namespace dmp {
                 {TOKEN_REAL64 , TYPE_REAL64}
             };
 
-            result = std::make_shared<PrimitiveTypeNode>(tymap[tokens[it]->is]);
-            result->loc = tokens[it]->loc;
+            result = ast->make<PrimitiveTypeNode>(tymap[tokens.kind(it)]);
+            result->loc = tokens.loc(it);
             return success(1);
         }
 
@@ -93,12 +97,12 @@ namespace dmp {
 
         std::size_t n = 0;
 
-        std::shared_ptr<Node> pointee;
+        Node* pointee = nullptr;
 
         if (parseToken(it, TOKEN_GENERIC_POINTER)) {
-            pointee = std::make_shared<UnknownTypeNode>();
-            result = std::make_shared<PointerTypeNode>(pointee);
-            result->loc = tokens[it]->loc;
+            pointee = ast->make<UnknownTypeNode>();
+            result = ast->make<PointerTypeNode>(pointee);
+            result->loc = tokens.loc(it);
             return success(1);
         }
 
@@ -108,7 +112,7 @@ namespace dmp {
         n++;
 
         if (parseToken(it+n, TOKEN_IDENT)) {
-            pointee = std::make_shared<Identifier>(tokens[it+n]->str, tokens[it+n]->loc);
+            pointee = ast->make<Identifier>(tokens.str(it+n), tokens.loc(it+n));
             n++;
         }
         else if (parseType(it+n)) {
@@ -116,12 +120,12 @@ namespace dmp {
             n += nParsed;
         }
         else {
-            return error(tokens[it+n], "Failed to parse pointee type");
+            return error(tokens.loc(it+n), "Failed to parse pointee type");
         }
 
-        auto loc = tokens[it]->loc;
+        auto loc = tokens.loc(it);
         loc.end = pointee->loc.end;
-        result = std::make_shared<PointerTypeNode>(pointee);
+        result = ast->make<PointerTypeNode>(pointee);
         result->loc = loc;
         return success(n);
     }
@@ -137,26 +141,26 @@ namespace dmp {
 
         std::size_t n = 0;
 
-        std::shared_ptr<Node> nelem;
-        std::shared_ptr<Node> array_of;
+        Node* nelem = nullptr;
+        Node* array_of = nullptr;
 
         if (!parseToken(it, TOKEN_SQUARE_OPEN)) {
             return error();
         }
         n++;
         if (!parseExpr(it+n)) {
-            return error(tokens[it+n], "Failed to parse array size after \'[\'");
+            return error(tokens.loc(it+n), "Failed to parse array size after \'[\'");
         }
         n += nParsed;
         nelem = result;
         if (!parseToken(it+n, TOKEN_SQUARE_CLOSE)) {
-            return error(tokens[it+n], "Expect \']\'");
+            return error(tokens.loc(it+n), "Expect \']\'");
         }
         n++;
 
 
         if (parseToken(it+n, TOKEN_IDENT)) {
-            array_of = std::make_shared<Identifier>(tokens[it+n]->str, tokens[it+n]->loc);
+            array_of = ast->make<Identifier>(tokens.str(it+n), tokens.loc(it+n));
             n++;
         }
         else if (parseType(it+n)) {
@@ -164,19 +168,19 @@ namespace dmp {
             array_of = result; 
         }
         else {
-            return error(tokens[it+n], "Failed to parse array type");
+            return error(tokens.loc(it+n), "Failed to parse array type");
         }
 
-        auto loc = tokens[it]->loc;
+        auto loc = tokens.loc(it);
         loc.end = array_of->loc.end;
-        result = std::make_shared<ArrayTypeNode>(array_of, nelem);
+        result = ast->make<ArrayTypeNode>(array_of, nelem);
         result->loc = loc;
         return success(n);
     }
 
     /*
 
-    STRUCT_TYPE : 'struct' ['packed'] MEMBER_SET
+    STRUCT_TYPE : 'struct' ['packed'] [ALIGNMENT] MEMBER_SET
 
     */
 
@@ -185,6 +189,7 @@ namespace dmp {
         std::size_t n = 0;
 
         bool packed = false;
+        Node* align = nullptr;
 
         if (!parseToken(it, TOKEN_STRUCT)) {
             return error();
@@ -196,18 +201,26 @@ namespace dmp {
             n++;
         }
 
+        if (parseToken(it+n, TOKEN_ALIGN)) {
+            if (!parseAlignment(it+n)) {
+                return error();
+            }
+            align = result;
+            n += nParsed;
+        }
+
         if (!parseMembers(it+n)) {
             return error();
         }
-        auto members = std::static_pointer_cast<NameNodeSet>(result);
+        auto members = static_cast<NameNodeSet*>(result);
         if (members->set.size() == 0) {  
-            return error(tokens[it+n], "Empty struct is not allowed");
+            return error(tokens.loc(it+n), "Empty struct is not allowed");
         }
         n += nParsed;
 
-        auto loc = tokens[it]->loc;
+        auto loc = tokens.loc(it);
         loc.end = members->loc.end;
-        result = std::make_shared<StructTypeNode>(members, packed);
+        result = ast->make<StructTypeNode>(members, packed, align);
         result->loc = loc;
         return success(n);
     }
@@ -231,15 +244,15 @@ namespace dmp {
         if (!parseMembers(it+n)) {
             return error();
         }
-        auto members = std::static_pointer_cast<NameNodeSet>(result);
+        auto members = static_cast<NameNodeSet*>(result);
         if (members->set.size() == 0) {  
-            return error(tokens[it+n], "Empty union is not allowed");
+            return error(tokens.loc(it+n), "Empty union is not allowed");
         }
         n += nParsed;
 
-        auto loc = tokens[it]->loc;
+        auto loc = tokens.loc(it);
         loc.end = members->loc.end;
-        result = std::make_shared<UnionTypeNode>(members);
+        result = ast->make<UnionTypeNode>(members);
         result->loc = loc;
         return success(n);
     }
@@ -259,13 +272,13 @@ namespace dmp {
         if (!parseToken(it, TOKEN_FUNCTION)) {
             return error();
         }
-        auto loc = tokens[it]->loc;
+        auto loc = tokens.loc(it);
         n++;
 
         if (!parseArguments(it+n)) {
             return error();
         }
-        auto args = std::static_pointer_cast<NameNodeSet>(result);
+        auto args = static_cast<NameNodeSet*>(result);
         for (std::size_t i = 0; i < args->set.size(); i++) {
             if (!args->set[i].name) {
                 return error(args->set[i], "Unnamed function argument");
@@ -273,9 +286,9 @@ namespace dmp {
         }
         n += nParsed;
 
-        std::shared_ptr<Node> ret;
+        Node* ret = nullptr;
         if (!parseToken(it+n, TOKEN_RETURNS)) {
-            ret = std::make_shared<VoidTypeNode>();
+            ret = ast->make<VoidTypeNode>();
             loc.end = args->loc.end;
         }
         else {
@@ -285,16 +298,16 @@ namespace dmp {
                 ret = result;
             }
             else if (parseToken(it+n, TOKEN_IDENT)) {
-                ret = std::make_shared<Identifier>(tokens[it+n]->str, tokens[it+n]->loc);
+                ret = ast->make<Identifier>(tokens.str(it+n), tokens.loc(it+n));
                 n++;
             }
             else {
-                return error(tokens[it+n], "Failed to parse function return type");
+                return error(tokens.loc(it+n), "Failed to parse function return type");
             }
             loc.end = ret->loc.end;
         }
 
-        result = std::make_shared<FunctionTypeNode>(args, ret);
+        result = ast->make<FunctionTypeNode>(args, ret);
         result->loc = loc;
         return success(n);
     }
@@ -312,34 +325,34 @@ namespace dmp {
     bool Parser::parseMembers(std::size_t it) {
 
         std::size_t n = 0;
-        auto nns = std::make_shared<NameNodeSet>();
+        auto nns = ast->make<NameNodeSet>();
 
         if (!parseToken(it, TOKEN_ROUND_OPEN)) {
-            return error(tokens[it], "Expect \'(\' after " + tokens[it-1]->str);
+            return error(tokens.loc(it), "Expect \'(\' after " + tokens.str(it-1));
         }
         n++;
 
         while (true) {
-            std::shared_ptr<Identifier> name;
-            std::shared_ptr<Node> type;
+            Identifier* name = nullptr;
+            Node* type = nullptr;
             if (parseToken(it+n, TOKEN_IDENT) && parseToken(it+n+1, TOKEN_DECLARE) && parseToken(it+n+2, TOKEN_IDENT)) {
-                name = std::make_shared<Identifier>(tokens[it+n]->str, tokens[it+n]->loc);
-                type = std::make_shared<Identifier>(tokens[it+n+2]->str, tokens[it+n+2]->loc);
+                name = ast->make<Identifier>(tokens.str(it+n), tokens.loc(it+n));
+                type = ast->make<Identifier>(tokens.str(it+n+2), tokens.loc(it+n+2));
                 n += 3;
             }
             else if (parseToken(it+n, TOKEN_IDENT) && parseToken(it+n+1, TOKEN_DECLARE) && parseType(it+n+2)) {
-                name = std::make_shared<Identifier>(tokens[it+n]->str, tokens[it+n]->loc);
+                name = ast->make<Identifier>(tokens.str(it+n), tokens.loc(it+n));
                 type = result;
                 n += 2+nParsed;
             }
             else if (parseType(it+n)) {
-                name = std::make_shared<Identifier>();
+                name = ast->make<Identifier>();
                 type = result;
                 n += nParsed;
             }
             else if (parseToken(it+n, TOKEN_IDENT)) {
-                name = std::make_shared<Identifier>();
-                type = std::make_shared<Identifier>(tokens[it+n]->str, tokens[it+n]->loc);
+                name = ast->make<Identifier>();
+                type = ast->make<Identifier>(tokens.str(it+n), tokens.loc(it+n));
                 n++;
             }
             else {
@@ -357,16 +370,16 @@ namespace dmp {
 
         if (parseToken(it+n, TOKEN_ROUND_CLOSE)) {
             if (nns->set.size() == 0) {
-                return error(tokens[it+n], "Empty member set not allowed");
+                return error(tokens.loc(it+n), "Empty member set not allowed");
             }
-            auto loc = tokens[it]->loc;
-            loc.end = tokens[it+n]->loc.end;
+            auto loc = tokens.loc(it);
+            loc.end = tokens.loc(it+n).end;
             result = nns;
             result->loc = loc;
             n++;
             return success(n);
         }
-        return error(tokens[it+n], "Unable to parse member");
+        return error(tokens.loc(it+n), "Unable to parse member");
     }
 
     /*
@@ -382,28 +395,28 @@ namespace dmp {
     bool Parser::parseArguments(std::size_t it) {
 
         std::size_t n = 0;
-        auto nns = std::make_shared<NameNodeSet>();
+        auto nns = ast->make<NameNodeSet>();
 
         if (!parseToken(it, TOKEN_ROUND_OPEN)) {
-            return error(tokens[it], "Expect \'(\' after " + tokens[it-1]->str);
+            return error(tokens.loc(it), "Expect \'(\' after " + tokens.str(it-1));
         }
         n++;
 
         while (true) {
-            std::shared_ptr<Identifier> name;
-            std::shared_ptr<Node> type;
+            Identifier* name = nullptr;
+            Node* type = nullptr;
             uint64_t attr = 0;
             if (parseToken(it+n, TOKEN_DEREF)) {
                 attr |= PASS_BY_REFERENCE;
                 n++;
             }
             if (parseToken(it+n, TOKEN_IDENT) && parseToken(it+n+1, TOKEN_DECLARE) && parseToken(it+n+2, TOKEN_IDENT)) {
-                name = std::make_shared<Identifier>(tokens[it+n]->str, tokens[it+n]->loc);
-                type = std::make_shared<Identifier>(tokens[it+n+2]->str, tokens[it+n+2]->loc);
+                name = ast->make<Identifier>(tokens.str(it+n), tokens.loc(it+n));
+                type = ast->make<Identifier>(tokens.str(it+n+2), tokens.loc(it+n+2));
                 n += 3;
             }
             else if (parseToken(it+n, TOKEN_IDENT) && parseToken(it+n+1, TOKEN_DECLARE) && parseType(it+n+2)) {
-                name = std::make_shared<Identifier>(tokens[it+n]->str, tokens[it+n]->loc);
+                name = ast->make<Identifier>(tokens.str(it+n), tokens.loc(it+n));
                 type = result;
                 n += 2+nParsed;
             }
@@ -421,15 +434,49 @@ namespace dmp {
         }
 
         if (parseToken(it+n, TOKEN_ROUND_CLOSE)) {
-            auto loc = tokens[it]->loc;
-            loc.end = tokens[it+n]->loc.end;
+            auto loc = tokens.loc(it);
+            loc.end = tokens.loc(it+n).end;
             result = nns;
             result->loc = loc;
             n++;
             return success(n);
         }
-        return error(tokens[it+n], "Unable to parse argument");
+        return error(tokens.loc(it+n), "Unable to parse argument");
     }
 
+    /*
+
+    ALIGNMENT : 'align' '(' EXPR ')'
+
+    */
+
+    bool Parser::parseAlignment(std::size_t it) {
+
+        std::size_t n = 0;
+
+        if (!parseToken(it, TOKEN_ALIGN)) {
+            return error();
+        }
+        n++;
+
+        if (!parseToken(it+n, TOKEN_ROUND_OPEN)) {
+            return error(tokens.loc(it+n), "Expect \'(\' after \'align\'");
+        }
+        n++;
+
+        if (!parseExpr(it+n)) {
+            return error(tokens.loc(it+n), "Failed to parse alignment after \'align(\'");
+        }
+        n += nParsed;
+        auto align = result;
+
+        if (!parseToken(it+n, TOKEN_ROUND_CLOSE)) {
+            return error(tokens.loc(it+n), "Expect \')\'");
+        }
+        n++;
+
+        result = align;
+        return success(n);
+    }
 
 }
@@ -1,7 +1,15 @@
-#include <iostream>
-#include <Common/Globals.h>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <sstream>
+#include <set>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <Common/CompilationContext.h>
 #include <Start/Compile.h>
 #include <IO/InputManager.h>
+#include <IO/IncludeCache.h>
 #include <AST/AST.h>
 #include <IR/GST.h>
 #include <Parser/Parser.h>
@@ -10,40 +18,212 @@
 
 namespace dmp {
 
-    void compile(const std::string& srcfile, const std::string& outfile) {
+    CompileOptions::CompileOptions():
+        optlevel(OPT_LEVEL_O0),
+        outputkind(OUTPUT_OBJECT),
+        memoize(false),
+        ssa(false),
+        triple(""),
+        directory(""),
+        cachedir(""),
+        cachemem(false)
+    {
+    }
+
+    CompileJob::CompileJob():
+        outdir(""),
+        jobs(1)
+    {
+    }
+
+    static std::string resolve(const std::string& directory, const std::string& path) {
+        if (directory.empty() || !llvm::sys::path::is_relative(path)) {
+            return path;
+        }
+        llvm::SmallString<256> p(directory);
+        llvm::sys::path::append(p, path);
+        return std::string(p.str());
+    }
+
+    static std::string outputName(const std::string& srcfile, const std::string& outdir, uint16_t outputkind) {
+
+        std::string ext;
+        switch (outputkind) {
+            case OUTPUT_ASSEMBLY : ext = ".s";  break;
+            case OUTPUT_LLVM_IR  : ext = ".ll"; break;
+            case OUTPUT_BITCODE  : ext = ".bc"; break;
+            default              : ext = ".o";
+        }
+
+        llvm::SmallString<256> p(outdir);
+        llvm::sys::path::append(p, std::string(llvm::sys::path::stem(srcfile)) + ext);
+        return std::string(p.str());
+    }
+
+    bool CompileJob::parse(const std::vector<std::string>& args, std::ostream& err) {
+
+        bool hasOutdir = false;
+        std::vector<std::string> files;
+
+        for (std::size_t i = 0; i < args.size(); i++) {
+            const auto& arg = args[i];
+            if      (arg == "-O0") opts.optlevel = OPT_LEVEL_O0;
+            else if (arg == "-O1") opts.optlevel = OPT_LEVEL_O1;
+            else if (arg == "-O2") opts.optlevel = OPT_LEVEL_O2;
+            else if (arg == "-O3") opts.optlevel = OPT_LEVEL_O3;
+            else if (arg == "-Os") opts.optlevel = OPT_LEVEL_OS;
+            else if (arg == "-Oz") opts.optlevel = OPT_LEVEL_OZ;
+            else if (arg == "-c"        ) opts.outputkind = OUTPUT_OBJECT;
+            else if (arg == "-S"        ) opts.outputkind = OUTPUT_ASSEMBLY;
+            else if (arg == "-emit-llvm") opts.outputkind = OUTPUT_LLVM_IR;
+            else if (arg == "-emit-bc"  ) opts.outputkind = OUTPUT_BITCODE;
+            else if (arg == "-fmemoize" ) opts.memoize = true;
+            else if (arg == "-fssa"     ) opts.ssa = true;
+            else if (arg == "--target" && i+1 < args.size()) opts.triple = args[++i];
+            else if (arg.compare(0, 9, "--target=") == 0) opts.triple = arg.substr(9);
+            else if (arg == "--include-cache" && i+1 < args.size()) opts.cachedir = args[++i];
+            else if (arg.compare(0, 16, "--include-cache=") == 0) opts.cachedir = arg.substr(16);
+            else if (arg == "-o" && i+1 < args.size()) {
+                outdir = args[++i];
+                hasOutdir = true;
+            }
+            else if (arg.compare(0, 2, "-j") == 0) {
+                std::string n = (arg.size() > 2 ? arg.substr(2) : (i+1 < args.size() ? args[++i] : ""));
+                if (n.empty() || n.size() > 6 || n.find_first_not_of("0123456789") != std::string::npos || std::stoul(n) == 0) {
+                    err << "Expect a positive number of jobs after -j" << std::endl;
+                    return false;
+                }
+                jobs = std::stoul(n);
+            }
+            else if (arg.size() > 1 && arg[0] == '-') {
+                err << "Unknown option " << arg << std::endl;
+                return false;
+            }
+            else {
+                files.push_back(arg);
+            }
+        }
 
-        TheContext      = std::make_unique<llvm::LLVMContext>();
-        TheModule       = std::make_unique<llvm::Module>("DIMPLE module", *TheContext);
-        TheBuilder      = std::make_unique<llvm::IRBuilder<> >(*TheContext);
+        if (!hasOutdir) {
+            if (files.size() != 2) {
+                err << "Usage: dimple [-O0|-O1|-O2|-O3|-Os|-Oz] [-c|-S|-emit-llvm|-emit-bc] [-fmemoize] [-fssa] [--target triple] [--include-cache dir] source.file output.file" << std::endl;
+                err << "       dimple [options] [-j N] source.file ... -o output.dir" << std::endl;
+                err << "       dimple --server socket [-j N]" << std::endl;
+                err << "       dimple --connect socket [options] source.file output.file" << std::endl;
+                return false;
+            }
+            srcfiles.push_back(files[0]);
+            outfiles.push_back(files[1]);
+            return true;
+        }
+
+        if (files.empty()) {
+            err << "No source files to compile" << std::endl;
+            return false;
+        }
+
+        std::set<std::string> names;
+        for (const auto& f : files) {
+            srcfiles.push_back(f);
+            outfiles.push_back(outputName(f, outdir, opts.outputkind));
+            if (!names.insert(outfiles.back()).second) {
+                err << "More than one source file would be compiled to " << outfiles.back() << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool CompileJob::run(std::ostream& err) const {
+
+        if (!outdir.empty()) {
+            if (auto ec = llvm::sys::fs::create_directories(resolve(opts.directory, outdir))) {
+                err << "Unable to create output directory " << outdir << "; " << ec.message() << std::endl;
+                return false;
+            }
+        }
+
+        /* The sources of one invocation share the include files they have in common */
+        auto o = opts;
+        o.cachemem = o.cachemem || srcfiles.size() > 1;
+        return compile(srcfiles, outfiles, jobs, o, err);
+    }
+
+    bool compile(const std::string& srcfile, const std::string& outfile, const CompileOptions& opts, std::ostream& err) {
+
+        auto context    = std::make_unique<CompilationContext>("DIMPLE module");
 
         auto input      = std::make_unique<InputManager>();
         auto ast        = std::make_unique<AST>();
         auto gst        = std::make_unique<GST>();
 
-        auto parser     = std::make_unique<Parser>(input.get(), ast.get());
-        auto translator = std::make_unique<Translator>(input.get(), ast.get(), gst.get());
-        auto backend    = std::make_unique<Backend>(srcfile, outfile);
+        std::unique_ptr<IncludeCache> cache;
+        if (!opts.cachedir.empty() || opts.cachemem) {
+            cache = std::make_unique<IncludeCache>(opts.cachedir.empty() ? "" : resolve(opts.directory, opts.cachedir), opts.cachemem);
+        }
+
+        auto parser     = std::make_unique<Parser>(input.get(), ast.get(), opts.memoize, cache.get());
+        auto translator = std::make_unique<Translator>(input.get(), ast.get(), gst.get(), opts.ssa);
+        auto backend    = std::make_unique<Backend>(srcfile, resolve(opts.directory, outfile), opts.optlevel, opts.outputkind, opts.triple);
 
+        input->directory = opts.directory;
         input->set(srcfile);
         if (!input->isValid()) {
-            std::cerr << "Unable to open source file " + srcfile;
+            err << "Unable to open source file " + srcfile;
         }
 
 	else if (!parser->run()) {
-            std::cerr << parser->errorPrintout();
+            err << parser->errorPrintout();
         }
 
 	else if (!translator->run()) {
-            std::cerr << translator->errorPrintout();
+            err << translator->errorPrintout();
         }
 
 	else if (!backend->run()) {
-            std::cerr << backend->errorPrintout();
+            err << backend->errorPrintout();
+        }
+
+	else {
+            return true;
+        }
+        return false;
+    }
+
+    /*
+    Compile independent source files on a pool of threads, each compilation with its own context. The diagnostics of
+    a file are collected and printed in one piece once it is done, so that messages of different files do not mix
+    */
+    bool compile(const std::vector<std::string>& srcfiles, const std::vector<std::string>& outfiles, std::size_t jobs, const CompileOptions& opts, std::ostream& out) {
+
+        std::atomic<std::size_t> next(0);
+        std::atomic<bool> ok(true);
+        std::mutex print;
+
+        auto worker = [&]() {
+            for (std::size_t i = next++; i < srcfiles.size(); i = next++) {
+                std::ostringstream err;
+                if (!compile(srcfiles[i], outfiles[i], opts, err)) {
+                    ok = false;
+                }
+                if (err.tellp() > 0) {
+                    std::lock_guard<std::mutex> lock(print);
+                    out << err.str();
+                }
+            }
+        };
+
+        jobs = std::max<std::size_t>(1, std::min(jobs, srcfiles.size()));
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < jobs; i++) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& t : threads) {
+            t.join();
         }
 
-	TheModule.reset();
-	TheContext.reset();
-	TheBuilder.reset();
+        return ok;
     }
 
 }
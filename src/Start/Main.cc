@@ -1,14 +1,23 @@
 #include <iostream>
+#include <string>
+#include <vector>
 #include <Start/Compile.h>
+#include <Start/Server.h>
 
 int main(int argc, char* argv[]) {
 
-    if (argc != 3) {
-        std::cerr << "Usage: dmp source.file output.file" << std::endl;
-        return 0;
+    std::vector<std::string> args(argv + 1, argv + argc);
+
+    if (args.size() > 0 && args[0] == "--server") {
+        return dmp::runServer(args);
+    }
+    if (args.size() > 0 && args[0] == "--connect") {
+        return dmp::runClient(args);
     }
 
-    dmp::compile(argv[1], argv[2]);
-    return 0;
+    dmp::CompileJob job;
+    if (!job.parse(args, std::cerr)) {
+        return 1;
+    }
+    return job.run(std::cerr) ? 0 : 1;
 }
-
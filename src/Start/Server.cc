@@ -0,0 +1,265 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <sstream>
+#include <iostream>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <Start/Server.h>
+#include <Start/Compile.h>
+#include <Backend/Backend.h>
+
+namespace dmp {
+
+    /* A client has this long to send its whole request (and to take the reply), so that it cannot hold a worker */
+    static constexpr int request_timeout_ms = 10000;
+
+    /* With a timeout (in milliseconds), reading fails once it has run out, however much data has arrived by then */
+    static bool readAll(int fd, std::string& data, int timeout = -1) {
+        char buf[4096];
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+        while (true) {
+            if (timeout >= 0) {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+                pollfd pfd = {fd, POLLIN, 0};
+                int ready = (left > 0 ? ::poll(&pfd, 1, int(left)) : 0);
+                if (ready < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (ready <= 0) {
+                    return false;
+                }
+            }
+            auto n = ::read(fd, buf, sizeof(buf));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n < 0) {
+                return false;
+            }
+            if (n == 0) {
+                return true;
+            }
+            data.append(buf, n);
+        }
+    }
+
+    static bool writeAll(int fd, const std::string& data) {
+        std::size_t written = 0;
+        while (written < data.size()) {
+            auto n = ::write(fd, data.data() + written, data.size() - written);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n < 0) {
+                return false;
+            }
+            written += n;
+        }
+        return true;
+    }
+
+    static bool socketAddress(const std::string& path, sockaddr_un& addr) {
+        if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+            return false;
+        }
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path.c_str(), path.size());
+        return true;
+    }
+
+    /* Only the user running the server may use it (the socket file is also restricted to its owner) */
+    static bool isOwner(int fd) {
+#ifdef SO_PEERCRED
+        ucred cred;
+        socklen_t len = sizeof(cred);
+        return ::getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) == 0 && cred.uid == ::getuid();
+#else
+        uid_t uid;
+        gid_t gid;
+        return ::getpeereid(fd, &uid, &gid) == 0 && uid == ::getuid();
+#endif
+    }
+
+    static void serve(int fd, int listener, std::atomic<bool>& stopped) {
+
+        std::string request;
+        if (!isOwner(fd) || !readAll(fd, request, request_timeout_ms)) {
+            return;
+        }
+
+        std::vector<std::string> fields;
+        std::size_t begin = 0;
+        for (std::size_t end = request.find('\0'); end != std::string::npos; end = request.find('\0', begin)) {
+            fields.push_back(request.substr(begin, end - begin));
+            begin = end + 1;
+        }
+
+        std::ostringstream err;
+        bool ok = false;
+        if (fields.size() == 2 && fields[1] == "--shutdown") {
+            stopped = true;
+            ::shutdown(listener, SHUT_RDWR);
+            ok = true;
+        }
+        else if (fields.empty()) {
+            err << "Invalid request" << std::endl;
+        }
+        else {
+            CompileJob job;
+            job.opts.directory = fields[0];
+            job.opts.cachemem = true;
+            if (job.parse(std::vector<std::string>(fields.begin() + 1, fields.end()), err)) {
+                ok = job.run(err);
+            }
+        }
+
+        writeAll(fd, std::string(1, ok ? '0' : '1') + err.str());
+    }
+
+    int runServer(const std::vector<std::string>& args) {
+
+        std::size_t jobs = 1;
+        if (args.size() == 3 && args[2].compare(0, 2, "-j") == 0 && args[2].size() > 2) {
+            jobs = std::strtoul(args[2].c_str() + 2, nullptr, 10);
+        }
+        else if (args.size() == 4 && args[2] == "-j") {
+            jobs = std::strtoul(args[3].c_str(), nullptr, 10);
+        }
+        else if (args.size() != 2) {
+            std::cerr << "Usage: dimple --server socket [-j N]" << std::endl;
+            return 1;
+        }
+        if (jobs == 0) {
+            std::cerr << "Expect a positive number of jobs after -j" << std::endl;
+            return 1;
+        }
+
+        const auto& path = args[1];
+        sockaddr_un addr;
+        if (!socketAddress(path, addr)) {
+            std::cerr << "Invalid socket path " << path << std::endl;
+            return 1;
+        }
+
+        /* A socket file left behind by a server that is no longer running is removed; anything else is not touched */
+        struct stat st;
+        if (::stat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+            int probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            bool alive = (probe >= 0 && ::connect(probe, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+            if (probe >= 0) {
+                ::close(probe);
+            }
+            if (alive) {
+                std::cerr << "A dimple server is already listening on " << path << std::endl;
+                return 1;
+            }
+            ::unlink(path.c_str());
+        }
+
+        int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0 ||
+            ::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+            ::chmod(path.c_str(), S_IRUSR | S_IWUSR) < 0 ||
+            ::listen(listener, 64) < 0)
+        {
+            std::cerr << "Unable to listen on " << path << "; " << std::strerror(errno) << std::endl;
+            if (listener >= 0) {
+                ::close(listener);
+            }
+            return 1;
+        }
+
+        /* A client that goes away before reading its reply must not bring the server down */
+        std::signal(SIGPIPE, SIG_IGN);
+        HostTarget::get();
+
+        std::atomic<bool> stopped(false);
+        auto worker = [&]() {
+            while (!stopped) {
+                int fd = ::accept(listener, nullptr, nullptr);
+                if (fd < 0) {
+                    if (errno == EINTR || errno == ECONNABORTED) {
+                        continue;
+                    }
+                    break;
+                }
+                timeval tv = {request_timeout_ms / 1000, 0};
+                ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+                serve(fd, listener, stopped);
+                ::close(fd);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < jobs; i++) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        ::close(listener);
+        ::unlink(path.c_str());
+        return 0;
+    }
+
+    int runClient(const std::vector<std::string>& args) {
+
+        if (args.size() < 3) {
+            std::cerr << "Usage: dimple --connect socket [options] source.file output.file" << std::endl;
+            return 1;
+        }
+
+        const auto& path = args[1];
+        sockaddr_un addr;
+        if (!socketAddress(path, addr)) {
+            std::cerr << "Invalid socket path " << path << std::endl;
+            return 1;
+        }
+
+        llvm::SmallString<256> cwd;
+        if (llvm::sys::fs::current_path(cwd)) {
+            std::cerr << "Unable to determine the current directory" << std::endl;
+            return 1;
+        }
+        std::string request(cwd.str());
+        request.push_back('\0');
+        for (std::size_t i = 2; i < args.size(); i++) {
+            request += args[i];
+            request.push_back('\0');
+        }
+
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            std::cerr << "Unable to connect to a dimple server on " << path << "; " << std::strerror(errno) << std::endl;
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            return 1;
+        }
+
+        std::string reply;
+        bool ok = writeAll(fd, request) && ::shutdown(fd, SHUT_WR) == 0 && readAll(fd, reply) && !reply.empty();
+        ::close(fd);
+        if (!ok) {
+            std::cerr << "Lost the connection to the dimple server on " << path << std::endl;
+            return 1;
+        }
+
+        std::cerr << reply.substr(1);
+        return reply[0] == '0' ? 0 : 1;
+    }
+
+}
@@ -2,8 +2,9 @@
 
 namespace dmp {
 
-    Translator::Translator(InputManager* in, AST* tree, GST* sym):
-        Pass(in, tree, sym)
+    Translator::Translator(InputManager* in, AST* tree, GST* sym, bool s):
+        Pass(in, tree, sym),
+        ssa(s)
     {
     }
 
@@ -16,13 +17,14 @@ namespace dmp {
     }
 
     bool Translator::createRepresentations() {
-        for (const auto& rep : ast->representations) {
-            const auto& name = rep.second->name;
-            const auto& node = rep.second->node;
+        auto ids = ast->representations.keys();
+        TheInterner->sort(ids);
+        for (auto id : ids) {
+            const auto& name = ast->representations[id]->name;
 
             auto nsnode = ast->getNonSynonymRepNode(name);
             if (nsnode->kind == NODE_IDENTIFIER) {
-                auto ident = static_cast<Identifier*>(nsnode.get());
+                auto ident = static_cast<Identifier*>(nsnode);
                 return error(nsnode, ident->name + " is not a representation");
             }
             if (getTypeRep(name) || getConstRep(name)) {
@@ -34,14 +36,18 @@ namespace dmp {
     }
 
     bool Translator::createGlobals() {
-        for (const auto& decl : ast->declarations) {
-            const auto& name = decl.second->name;
+        auto ids = ast->declarations.keys();
+        TheInterner->sort(ids);
+        for (auto id : ids) {
+            const auto& name = ast->declarations[id]->name;
             if (!getGlobalInstance(name)) {
                 return error(name, "Unable to construct global " + name->name);
             }
         }
-        for (const auto& defn : ast->definitions) {
-            const auto& name = defn.second->name;
+        ids = ast->definitions.keys();
+        TheInterner->sort(ids);
+        for (auto id : ids) {
+            const auto& name = ast->definitions[id]->name;
             if (!getGlobalInstance(name)) {
                 return error(name, "Unable to construct global " + name->name);
             }
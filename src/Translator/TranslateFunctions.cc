@@ -10,9 +10,10 @@
 
 namespace dmp {
 
-    bool Translator::getFunction(const std::shared_ptr<Identifier>& ident, uint16_t storage, const std::shared_ptr<Type>& type) {
+    bool Translator::getFunction(Identifier* ident, uint16_t storage, const std::shared_ptr<Type>& type) {
 
         const auto& n = ident->name;
+        auto id = ident->id;
 
         if (n == "main") {
             auto ftype = static_cast<FunctionType*>(type.get());
@@ -45,26 +46,30 @@ namespace dmp {
             }
         }
 
-        gst->functions[n] = std::make_shared<Function>(storage, n, type);
-        gst->functions[n]->declare();
-        if (ast->definitions.find(n) != ast->definitions.end()) {
-            if (!defineFunction(ast->definitions[n])) {
+        if (ast->definitions.contains(id) && ast->definitions[id]->align) {
+            return error(ast->definitions[id]->align, "Cannot specify the alignment of a function");
+        }
+
+        gst->functions[id] = std::make_shared<Function>(storage, n, type);
+        gst->functions[id]->declare();
+        if (ast->definitions.contains(id)) {
+            if (!defineFunction(ast->definitions[id])) {
                 return error();
             }
-            gst->functions[n] = std::static_pointer_cast<Function>(result);
+            gst->functions[id] = std::static_pointer_cast<Function>(result);
         }
 
-        result = gst->functions[n];
+        result = gst->functions[id];
         return success();
     }
 
-    bool Translator::defineFunction(const std::shared_ptr<DefineStatement>& defn) {
+    bool Translator::defineFunction(DefineStatement* defn) {
 
         auto cf = currentFunction;
         if (cf) {
             cf->freeze();
         }
-        currentFunction = gst->functions[defn->name->name];
+        currentFunction = gst->functions[defn->name->id];
         currentFunction->init();
 
         if (defn->def->kind == NODE_NULLINIT) {
@@ -75,17 +80,20 @@ namespace dmp {
             FunctionOp::ret(currentFunction, nullptr);
         }
         else if (defn->def->kind == NODE_STATEMENT) {
-            auto stmt = static_cast<Statement*>(defn->def.get());
+            auto stmt = static_cast<Statement*>(defn->def);
             if (stmt->is != BLOCK_FUNCTION) {
                 return error(stmt, "Invalid function body");
             }
-            if (!defineBlock(std::static_pointer_cast<BlockNode>(defn->def))) {
+            if (!defineBlock(static_cast<BlockNode*>(defn->def))) {
                 return error(defn->name, "Unable to define \'" + defn->name->name + "\'");
             }
             if (!currentFunction->checkTerminations()) {
                 return error(defn->name, "Function \'" + defn->name->name + "\' does not always return");
             }
             // Possible to simplify the IR here: currentFunction->simplify();
+            if (ssa) {
+                currentFunction->promote();
+            }
         }
         else {
             return error(defn->def, "Invalid function body");
@@ -99,7 +107,7 @@ namespace dmp {
         return success();
     }
 
-    bool Translator::call(const std::shared_ptr<CallExprNode>& callex, const std::shared_ptr<Variable>& retv) {
+    bool Translator::call(CallExprNode* callex, const std::shared_ptr<Variable>& retv) {
 
         if (!getValue(callex->func)) {
             return error(callex->func, "Unable to construct the function of the call expression");
@@ -143,7 +151,7 @@ namespace dmp {
         return success();
     }
 
-    bool Translator::ret(const std::shared_ptr<ReturnStatement>& retstat) {
+    bool Translator::ret(ReturnStatement* retstat) {
         auto ft = static_cast<FunctionType*>(currentFunction->type.get());
         if (!retstat->val && !ft->ret->isVoid()) {
             return error(retstat, "This function does not return void");
@@ -170,20 +178,21 @@ namespace dmp {
         return FunctionOp::ret(currentFunction, retval); // This should never be false
     }
 
-    bool Translator::defineLocalVar(const std::shared_ptr<DefineStatement>& definition) {
+    bool Translator::defineLocalVar(DefineStatement* definition) {
 
         const auto& n = definition->name->name;
+        auto id = definition->name->id;
 
         auto ft = static_cast<FunctionType*>(currentFunction->type.get());
         for (std::size_t i = 0; i < ft->args.size(); i++) {
-            if (ft->args[i].name && ft->args[i].name->name == n) {
+            if (ft->args[i].name && ft->args[i].name->id == id) {
                 return error(definition->name, "Cannot define variable with argument name " + n);
             }
         }
-        if (currentFunction->lst->isDefinedInThisScope(n)) {
+        if (currentFunction->lst->isDefinedInThisScope(id)) {
             return error(definition->name, "Cannot define variable with name " + n + ". Symbol name is already in use in this scope");
         }
-        if (ast->representations.find(n) != ast->representations.end()) {
+        if (ast->representations.contains(id)) {
             return error(definition->name, "\'" + n + "\' is also defined as a representation");
         }
 
@@ -209,30 +218,35 @@ namespace dmp {
                 return error(definition->type, "Variable type is not completely defined");
             }
             var = std::make_shared<Variable>(STORAGE_LOCAL, n, type);
+            if (definition->align && !getAlignment(definition->align, var->explicit_align)) {
+                return error();
+            }
+            var->declare();
             if (!initLocal(var, definition)) {
                 return error(definition->name, "Unable to initialize variable " + n);
             }
         }
 
-        currentFunction->lst->variables[n] = var;
+        currentFunction->lst->bind(id, var);
         result = var;
         return success();
     }
 
-    bool Translator::defineLocalRef(const std::shared_ptr<DefineStatement>& definition) {
+    bool Translator::defineLocalRef(DefineStatement* definition) {
 
         const auto& n = definition->name->name;
+        auto id = definition->name->id;
 
         auto ft = static_cast<FunctionType*>(currentFunction->type.get());
         for (std::size_t i = 0; i < ft->args.size(); i++) {
-            if (ft->args[i].name && ft->args[i].name->name == n) {
+            if (ft->args[i].name && ft->args[i].name->id == id) {
                 return error(definition->name, "Cannot define reference with argument name " + n);
             }
         }
-        if (currentFunction->lst->isDefinedInThisScope(n)) {
+        if (currentFunction->lst->isDefinedInThisScope(id)) {
             return error(definition->name, "Cannot define reference with name " + n + ". Symbol name is already in use in this scope");
         }
-        if (ast->representations.find(n) != ast->representations.end()) {
+        if (ast->representations.contains(id)) {
             return error(definition->name, "\'" + n + "\' is also defined as a representation");
         }
 
@@ -247,20 +261,20 @@ namespace dmp {
         if (referee->isVar()) {
             auto var = std::make_shared<Variable>(STORAGE_REFERENCE, n, referee->type);
             var->llvm_value = static_cast<Variable*>(referee.get())->ptr();
-            currentFunction->lst->variables[n] = var;
+            currentFunction->lst->bind(id, var);
             result = var;
         }
         else {
             auto func = std::make_shared<Function>(STORAGE_REFERENCE, n, referee->type);
             func->llvm_value = static_cast<Function*>(referee.get())->ptr();
-            currentFunction->lst->functions[n] = func;
+            currentFunction->lst->bind(id, func);
             result = func;
         }
 
         return success();
     }
 
-    bool Translator::defineBlock(const std::shared_ptr<BlockNode>& block, std::shared_ptr<CodeBlock> start, std::shared_ptr<CodeBlock> end) {
+    bool Translator::defineBlock(BlockNode* block, std::shared_ptr<CodeBlock> start, std::shared_ptr<CodeBlock> end) {
 
         for (const auto& statement : block->body) {
             if (statement->is == STATEMENT_CONTINUE) {
@@ -276,24 +290,24 @@ namespace dmp {
                 CodeBlock::jump(end);
             }
             else if (statement->is == STATEMENT_RETURN) {
-                if (!ret(std::static_pointer_cast<ReturnStatement>(statement))) {
+                if (!ret(static_cast<ReturnStatement*>(statement))) {
                     return error();
                 }
             }
             else if (statement->is == STATEMENT_CALL) {
-                auto callstat = static_cast<CallStatement*>(statement.get());
+                auto callstat = static_cast<CallStatement*>(statement);
                 if (!getValue(callstat->exp)) {
                     return error();
                 }
             }
             else if (statement->is == STATEMENT_ASSIGN) {
-                auto assignstat = static_cast<AssignStatement*>(statement.get());
+                auto assignstat = static_cast<AssignStatement*>(statement);
                 if (!getValue(assignstat->exp)) {
                     return error();
                 }
             }
             else if (statement->is == STATEMENT_DEFINE) {
-                auto defstat = std::static_pointer_cast<DefineStatement>(statement);
+                auto defstat = static_cast<DefineStatement*>(statement);
                 if (defstat->storage == STORAGE_REFERENCE) {
                     if (!defineLocalRef(defstat)) {
                         return error();
@@ -306,12 +320,12 @@ namespace dmp {
                 }
             }
             else if (statement->is == BLOCK_IF) {
-                if (!defineIfBlock(std::static_pointer_cast<BlockNode>(statement), start, end)) {
+                if (!defineIfBlock(static_cast<BlockNode*>(statement), start, end)) {
                     return error();
                 }
             }
             else if (statement->is == BLOCK_LOOP) {
-                if (!defineLoopBlock(std::static_pointer_cast<BlockNode>(statement))) {
+                if (!defineLoopBlock(static_cast<BlockNode*>(statement))) {
                     return error();
                 }
             }
@@ -323,13 +337,13 @@ namespace dmp {
         return success();
     }
 
-    bool Translator::defineIfBlock(const std::shared_ptr<BlockNode>& block, std::shared_ptr<CodeBlock> start, std::shared_ptr<CodeBlock> end) {
+    bool Translator::defineIfBlock(BlockNode* block, std::shared_ptr<CodeBlock> start, std::shared_ptr<CodeBlock> end) {
 
         auto mergeBB = std::make_shared<CodeBlock>();
 
         for (std::size_t i = 0; i < block->body.size(); i++) {
             
-            auto ifblock = std::static_pointer_cast<CondBlockNode>(block->body[i]);
+            auto ifblock = static_cast<CondBlockNode*>(block->body[i]);
             auto nextBB = std::make_shared<CodeBlock>();
             
             if (ifblock->condition) {
@@ -346,7 +360,7 @@ namespace dmp {
                 CodeBlock::insert(ifBB);
             }
             
-            auto newlst = std::make_shared<LST>(*currentFunction);
+            currentFunction->enscope();
             if (!defineBlock(ifblock, start, end)) {
                 return error();
             }
@@ -362,14 +376,14 @@ namespace dmp {
         return success();
     }
 
-    bool Translator::defineLoopBlock(const std::shared_ptr<BlockNode>& block) {
+    bool Translator::defineLoopBlock(BlockNode* block) {
 
-        auto newlst = std::make_shared<LST>(*currentFunction);
+        currentFunction->enscope();
 
         const auto& init = block->body[0];
         const auto& loop = block->body[1];
         const auto& updt = block->body[2];
-        auto loopblock = std::static_pointer_cast<CondBlockNode>(loop);
+        auto loopblock = static_cast<CondBlockNode*>(loop);
 
         // Attempting to make the loop IR as canonical as possible
         auto phdrBB  = std::make_shared<CodeBlock>(); // Preheader
@@ -380,7 +394,7 @@ namespace dmp {
 
         if (init) {
             if (init->is == STATEMENT_DEFINE) {
-                auto defstat = std::static_pointer_cast<DefineStatement>(init);
+                auto defstat = static_cast<DefineStatement*>(init);
                 if (defstat->storage == STORAGE_REFERENCE) {
                     if (!defineLocalRef(defstat)) {
                         return error();
@@ -393,13 +407,13 @@ namespace dmp {
                 }
             }
             else if (init->is == STATEMENT_ASSIGN) {
-                auto assignstat = static_cast<AssignStatement*>(init.get());
+                auto assignstat = static_cast<AssignStatement*>(init);
                 if (!getValue(assignstat->exp)) {
                     return error();
                 }
             }
             else if (init->is == STATEMENT_CALL) {
-                auto callstat = static_cast<CallStatement*>(init.get());
+                auto callstat = static_cast<CallStatement*>(init);
                 if (!getValue(callstat->exp)) {
                     return error();
                 }
@@ -427,21 +441,23 @@ namespace dmp {
         CodeBlock::jump(loopBB);
 
         CodeBlock::insert(loopBB);
+        currentFunction->enscope();
         if (!defineBlock(loopblock, updtBB, exitBB)) {
             return error();
         }
+        currentFunction->descope();
         CodeBlock::jump(updtBB);
 
         CodeBlock::insert(updtBB);
         if (updt) {
             if (updt->is == STATEMENT_ASSIGN) {
-                auto assignstat = static_cast<AssignStatement*>(updt.get());
+                auto assignstat = static_cast<AssignStatement*>(updt);
                 if (!getValue(assignstat->exp)) {
                     return error();
                 }
             }
             else if (updt->is == STATEMENT_CALL) {
-                auto callstat = static_cast<CallStatement*>(updt.get());
+                auto callstat = static_cast<CallStatement*>(updt);
                 if (!getValue(callstat->exp)) {
                     return error();
                 }
@@ -12,39 +12,40 @@
 
 namespace dmp {
 
-    bool Translator::getType(const std::shared_ptr<Node>& node, bool includeOpaquePtr) {
+    bool Translator::getType(Node* node, bool includeOpaquePtr) {
 
         if (node->kind == NODE_IDENTIFIER) {
-            return getTypeRep(std::static_pointer_cast<Identifier>(node), includeOpaquePtr);
+            return getTypeRep(static_cast<Identifier*>(node), includeOpaquePtr);
         }
         if (node->kind != NODE_TYPENODE) {
             return error();
         }
-        auto tnode = std::static_pointer_cast<TypeNode>(node);
+        auto tnode = static_cast<TypeNode*>(node);
 
         if (tnode->isPrimitive()) {
-            result = std::make_shared<PrimitiveType>(tnode->is);
+            result = TheTypeContext->primitive(tnode->is);
             return success();
         }
         switch (tnode->is) {
-            case TYPE_UNKNOWN  : result = std::make_shared<UnknownType>(); return success();
-            case TYPE_VOID     : result = std::make_shared<VoidType>(); return success();
-            case TYPE_POINTER  : return getPtrType(std::static_pointer_cast<PointerTypeNode>(tnode), includeOpaquePtr);
-            case TYPE_ARRAY    : return getArrayType(std::static_pointer_cast<ArrayTypeNode>(tnode), includeOpaquePtr);
-            case TYPE_STRUCT   : return getStructType(std::static_pointer_cast<StructTypeNode>(tnode), includeOpaquePtr);
-            case TYPE_UNION    : return getUnionType(std::static_pointer_cast<UnionTypeNode>(tnode), includeOpaquePtr);
-            case TYPE_FUNCTION : return getFunctionType(std::static_pointer_cast<FunctionTypeNode>(tnode), includeOpaquePtr);
+            case TYPE_UNKNOWN  : result = TheTypeContext->primitive(TYPE_UNKNOWN); return success();
+            case TYPE_VOID     : result = TheTypeContext->primitive(TYPE_VOID); return success();
+            case TYPE_POINTER  : return getPtrType(static_cast<PointerTypeNode*>(tnode), includeOpaquePtr);
+            case TYPE_ARRAY    : return getArrayType(static_cast<ArrayTypeNode*>(tnode), includeOpaquePtr);
+            case TYPE_STRUCT   : return getStructType(static_cast<StructTypeNode*>(tnode), includeOpaquePtr);
+            case TYPE_UNION    : return getUnionType(static_cast<UnionTypeNode*>(tnode), includeOpaquePtr);
+            case TYPE_FUNCTION : return getFunctionType(static_cast<FunctionTypeNode*>(tnode), includeOpaquePtr);
             default            : return error(tnode, "Unable to decipher type"); 
         }
     }
 
-    bool Translator::getTypeRep(const std::shared_ptr<Identifier>& ident, bool includeOpaquePtr) {
+    bool Translator::getTypeRep(Identifier* ident, bool includeOpaquePtr) {
 
         const auto& n = ident->name;
+        auto id = ident->id;
 
-        if (gst->types.find(n) != gst->types.end()) {
-            if (gst->types[n]->isComplete() || includeOpaquePtr) {
-                result = gst->types[n];
+        if (gst->types.contains(id)) {
+            if (gst->types[id]->isComplete() || includeOpaquePtr) {
+                result = gst->types[id];
                 return success();
             }
             else {
@@ -52,53 +53,53 @@ namespace dmp {
             }
         }
 
-        if (ast->representations.find(n) == ast->representations.end()) {
+        if (!ast->representations.contains(id)) {
             return error();
         }
         auto nsnode = ast->getNonSynonymRepNode(ident);
         if (nsnode->kind != NODE_TYPENODE) {
             return error();
         }
-        auto tnode = std::static_pointer_cast<TypeNode>(nsnode);
+        auto tnode = static_cast<TypeNode*>(nsnode);
 
         if (tnode->isPrimitive()) {
-            gst->types[n] = std::make_shared<PrimitiveType>(tnode->is);
+            gst->types[id] = TheTypeContext->primitive(tnode->is);
         }
         else {
             switch (tnode->is) {
-                case TYPE_POINTER  : gst->types[n] = std::make_shared<PointerType>(n); break;
-                case TYPE_ARRAY    : gst->types[n] = std::make_shared<ArrayType>(n); break;
-                case TYPE_STRUCT   : gst->types[n] = std::make_shared<StructType>(n, static_cast<StructTypeNode*>(tnode.get())->isPacked()); break;
-                case TYPE_UNION    : gst->types[n] = std::make_shared<UnionType>(n); break;
-                case TYPE_FUNCTION : gst->types[n+".ptr"] = std::make_shared<PointerType>(n); break;
+                case TYPE_POINTER  : gst->types[id] = std::make_shared<PointerType>(n); break;
+                case TYPE_ARRAY    : gst->types[id] = std::make_shared<ArrayType>(n); break;
+                case TYPE_STRUCT   : gst->types[id] = std::make_shared<StructType>(n, static_cast<StructTypeNode*>(tnode)->isPacked()); break;
+                case TYPE_UNION    : gst->types[id] = std::make_shared<UnionType>(n); break;
+                case TYPE_FUNCTION : gst->types[TheInterner->intern(n + ".ptr")] = std::make_shared<PointerType>(n); break;
                 default            : return error(tnode, "Unable to decipher type");
             }
         }
 
-        if (!getType(ast->representations[n]->node, includeOpaquePtr)) {
+        if (!getType(ast->representations[id]->node, includeOpaquePtr)) {
             return error();
         }
         auto ty = std::static_pointer_cast<Type>(result);
         if (ty->isFunction()) {
-            gst->types[n] = ty;
-            gst->types[n+".ptr"]->construct(std::make_shared<PointerType>(gst->types[n]));
+            gst->types[id] = ty;
+            gst->types[TheInterner->intern(n + ".ptr")]->construct(std::make_shared<PointerType>(gst->types[id]));
         }
         else {
-            gst->types[n]->construct(ty);
+            gst->types[id]->construct(ty);
         }
 
-        result = gst->types[n];
+        result = gst->types[id];
         return success();
     }
 
-    bool Translator::getPtrType(const std::shared_ptr<PointerTypeNode>& tnode, bool includeOpaquePtr) {
+    bool Translator::getPtrType(PointerTypeNode* tnode, bool includeOpaquePtr) {
 
         auto ptnode = tnode->points_to;
         if (ptnode->kind == NODE_IDENTIFIER) {
-            auto ident = std::static_pointer_cast<Identifier>(ptnode);
-            const auto& n = ident->name;
-            if (gst->types.find(n+".ptr") != gst->types.end()) {
-                result = gst->types[n+".ptr"];
+            auto ident = static_cast<Identifier*>(ptnode);
+            auto ptrid = TheInterner->intern(ident->name + ".ptr");
+            if (gst->types.contains(ptrid)) {
+                result = gst->types[ptrid];
                 return success();
             }
         }
@@ -106,11 +107,11 @@ namespace dmp {
             return error(ptnode, "Unable to create pointee type");
         }
         auto points_to = std::static_pointer_cast<Type>(result);
-        result = std::make_shared<PointerType>(points_to);
+        result = TheTypeContext->pointer(points_to);
         return success();
     }
 
-    bool Translator::getArrayType(const std::shared_ptr<ArrayTypeNode>& atnode, bool includeOpaquePtr) {
+    bool Translator::getArrayType(ArrayTypeNode* atnode, bool includeOpaquePtr) {
 
         if (!getType(atnode->array_of, includeOpaquePtr)) {
             return error(atnode->array_of, "Unable to create array element type");
@@ -133,16 +134,25 @@ namespace dmp {
         return success();
     }
 
-    bool Translator::getStructType(const std::shared_ptr<StructTypeNode>& stnode, bool includeOpaquePtr) {
+    bool Translator::getStructType(StructTypeNode* stnode, bool includeOpaquePtr) {
 
         std::vector<NameType> members;
         if (!checkDuplicateNames(stnode->members)) {
             return error();
         }
         bool packed = stnode->isPacked();
+        std::size_t align = 0;
+        if (stnode->align) {
+            if (packed) {
+                return error(stnode->align, "A packed struct cannot be given an alignment");
+            }
+            if (!getAlignment(stnode->align, align)) {
+                return error();
+            }
+        }
         for (std::size_t i = 0; i < stnode->members->set.size(); i++) {
             const NameNode& m = stnode->members->set[i];
-            if (m.name && ast->representations.find(m.name->name) != ast->representations.end()) {
+            if (m.name && ast->representations.contains(m.name->id)) {
                 return error(m.name, "\'" + m.name->name + "\' is also defined as a representation");
             }
             if (!getType(m.node, includeOpaquePtr)) {
@@ -155,11 +165,11 @@ namespace dmp {
             }
             members.push_back(NameType(m.name, ty));
         }
-        result = std::make_shared<StructType>(members, packed);
+        result = std::make_shared<StructType>(members, packed, align);
         return success();
     }
 
-    bool Translator::getUnionType(const std::shared_ptr<UnionTypeNode>& utnode, bool includeOpaquePtr) {
+    bool Translator::getUnionType(UnionTypeNode* utnode, bool includeOpaquePtr) {
 
         std::vector<NameType> members;
         if (!checkDuplicateNames(utnode->members)) {
@@ -167,7 +177,7 @@ namespace dmp {
         }
         for (std::size_t i = 0; i < utnode->members->set.size(); i++) {
             const NameNode& m = utnode->members->set[i];
-            if (m.name && ast->representations.find(m.name->name) != ast->representations.end()) {
+            if (m.name && ast->representations.contains(m.name->id)) {
                 return error(m.name, "\'" + m.name->name + "\' is also defined as a representation");
             }
             if (!getType(m.node, includeOpaquePtr)) {
@@ -184,7 +194,7 @@ namespace dmp {
         return success();
     }
 
-    bool Translator::getFunctionType(const std::shared_ptr<FunctionTypeNode>& ftnode, bool includeOpaquePtr) {
+    bool Translator::getFunctionType(FunctionTypeNode* ftnode, bool includeOpaquePtr) {
 
         std::vector<NameType> args;
         if (!checkDuplicateNames(ftnode->args)) {
@@ -192,7 +202,7 @@ namespace dmp {
         }
         for (std::size_t i = 0; i < ftnode->args->set.size(); i++) {
             const NameNode& a = ftnode->args->set[i];
-            if (ast->representations.find(a.name->name) != ast->representations.end()) {
+            if (ast->representations.contains(a.name->id)) {
                 return error(a.name, "\'" + a.name->name + "\' is also defined as a representation");
             }
             if (!getType(a.node, includeOpaquePtr)) {
@@ -215,7 +225,24 @@ namespace dmp {
         return success();
     }
 
-    bool Translator::checkDuplicateNames(const std::shared_ptr<NameNodeSet>& nns) {
+    bool Translator::getAlignment(Node* node, std::size_t& align) {
+
+        if (!getValue(node)) {
+            return error(node, "Unable to evaluate alignment");
+        }
+        auto av = std::static_pointer_cast<Value>(result);
+        if (!av->isConstNoRelocation() || !av->isConstNonNegativeInt()) {
+            return error(node, "Alignment is not a non-negative integer constant");
+        }
+        auto a = av->getUInt64ValueOrZero();
+        if (a == 0 || (a & (a-1)) != 0 || a > max_align) {
+            return error(node, "Alignment must be a power of 2 no larger than " + std::to_string(max_align));
+        }
+        align = a;
+        return success();
+    }
+
+    bool Translator::checkDuplicateNames(NameNodeSet* nns) {
 
         const auto& set = nns->set;
         for (std::size_t i = 0; i < set.size(); i++) {
@@ -226,7 +253,7 @@ namespace dmp {
                 if (!set[j].name) {
                     continue;
                 }
-                if (set[i].name->name == set[j].name->name) {
+                if (set[i].name->id == set[j].name->id) {
                     return error(set[j].name, "Duplicate member name \'" + set[j].name->name + "\'");
                 }
             }
@@ -11,19 +11,24 @@
 
 namespace dmp {
 
-    bool Translator::getValue(const std::shared_ptr<Node>& node) {
+    bool Translator::getValue(Node* node) {
         if (node->kind == NODE_IDENTIFIER) {
-            auto ident = std::static_pointer_cast<Identifier>(node);
-            auto n = ident->name;
+            auto ident = static_cast<Identifier*>(node);
+            const auto& n = ident->name;
+            auto id = ident->id;
             if (n == "main") {
                 return error(ident, "Invalid use of \'main\'");
             }
-            if (currentFunction && currentFunction->lst->isDefined(n)) {
-                result = currentFunction->lst->getInstance(n);
+            std::shared_ptr<Instance> local;
+            if (currentFunction) {
+                local = currentFunction->lst->getInstance(id);
             }
-            else if (ast->representations.find(n) != ast->representations.end() ||
-                     ast->declarations.find(n) != ast->declarations.end() ||
-                     ast->definitions.find(n) != ast->definitions.end()) 
+            if (local) {
+                result = local;
+            }
+            else if (ast->representations.contains(id) ||
+                     ast->declarations.contains(id) ||
+                     ast->definitions.contains(id)) 
             {
                 return getConstRep(ident) || getGlobalInstance(ident);
             }
@@ -37,77 +42,79 @@ namespace dmp {
             return error();
         }
 
-        auto expr = std::static_pointer_cast<ExprNode>(node);
+        auto expr = static_cast<ExprNode*>(node);
         switch (expr->is) {
             case EXPR_ASSIGN : return binary(expr);
             case EXPR_BINARY : return binary(expr);
-            case EXPR_CALL   : return call(std::static_pointer_cast<CallExprNode>(node));
-            case EXPR_UNARY  : return unary(std::static_pointer_cast<UnaryExprNode>(node));
+            case EXPR_CALL   : return call(static_cast<CallExprNode*>(node));
+            case EXPR_UNARY  : return unary(static_cast<UnaryExprNode*>(node));
             default          : return literal(expr);
         }
     }
 
-    bool Translator::getConstRep(const std::shared_ptr<Identifier>& ident) {
+    bool Translator::getConstRep(Identifier* ident) {
 
         auto n = ident->name;
-        if (gst->constants.find(n) != gst->constants.end()) {
-            if (!gst->constants[n]) {
+        auto id = ident->id;
+        if (gst->constants.contains(id)) {
+            if (!gst->constants[id]) {
                 return error(ident, "Cannot create a complete representation of " + n);
             }
-            result = gst->constants[n];
+            result = gst->constants[id];
             return success();
         }
-        else if (ast->representations.find(n) != ast->representations.end()) {
+        else if (ast->representations.contains(id)) {
             if (ast->getNonSynonymRepNode(ident)->kind != NODE_EXPRNODE) {
                 return error();
             }
-            gst->constants[n] = std::shared_ptr<Value>();
-            if (!getValue(ast->representations[n]->node)) {
+            gst->constants[id] = std::shared_ptr<Value>();
+            if (!getValue(ast->representations[id]->node)) {
                 return error();
             }
-            result = gst->constants[n] = std::static_pointer_cast<Value>(result);
+            result = gst->constants[id] = std::static_pointer_cast<Value>(result);
             return success();
         }
         return error();
     }
 
-    bool Translator::getGlobalInstance(const std::shared_ptr<Identifier>& ident) {
+    bool Translator::getGlobalInstance(Identifier* ident) {
 
         const auto& n = ident->name;
+        auto id = ident->id;
 
-        if (gst->functions.find(n) != gst->functions.end()) {
-            if (!gst->functions[n]) {
+        if (gst->functions.contains(id)) {
+            if (!gst->functions[id]) {
                 return error("Unable to completely define " + n);
             }
-            result = gst->functions[n];
+            result = gst->functions[id];
             return success();
         }
-        else if (gst->variables.find(n) != gst->variables.end()) {
-            if (!gst->variables[n]) {
+        else if (gst->variables.contains(id)) {
+            if (!gst->variables[id]) {
                 return error("Unable to completely define " + n);
             }
-            result = gst->variables[n];
+            result = gst->variables[id];
             return success();
         }
 
-        if (ast->declarations.find(n) == ast->declarations.end() &&
-            ast->definitions.find(n) == ast->definitions.end())
+        if (!ast->declarations.contains(id) &&
+            !ast->definitions.contains(id))
         {
             return error();
         }
 
-        std::shared_ptr<Node> tnode;
-        uint16_t storage = (ast->definitions.find(n) != ast->definitions.end() ? ast->definitions[n]->storage : STORAGE_EXTERNAL);
+        Node* tnode = nullptr;
+        uint16_t storage = (ast->definitions.contains(id) ? ast->definitions[id]->storage : STORAGE_EXTERNAL);
 
         if (storage == STORAGE_REFERENCE) {
             return getGlobalRef(ident);
         }
 
-        if (ast->declarations.find(n) != ast->declarations.end()) {
-            tnode = ast->declarations[n]->node;
+        if (ast->declarations.contains(id)) {
+            tnode = ast->declarations[id]->node;
         }
         else {
-            tnode = ast->definitions[n]->type;
+            tnode = ast->definitions[id]->type;
         }
 
         if (!tnode) {
@@ -116,19 +123,19 @@ namespace dmp {
 
         auto tynode = tnode;
         if (tynode->kind == NODE_IDENTIFIER) {
-            tynode = ast->getNonSynonymRepNode(std::static_pointer_cast<Identifier>(tnode));
+            tynode = ast->getNonSynonymRepNode(static_cast<Identifier*>(tnode));
         }
         if (tynode->kind == NODE_IDENTIFIER) {
-            return error(tynode, "\'" + static_cast<Identifier*>(tynode.get())->name + "\' is not a representation");
+            return error(tynode, "\'" + static_cast<Identifier*>(tynode)->name + "\' is not a representation");
         }
         if (tynode->kind != NODE_TYPENODE) {
-            return error(tnode, "\'" +  static_cast<Identifier*>(tnode.get())->name + "\' is not a type");
+            return error(tnode, "\'" +  static_cast<Identifier*>(tnode)->name + "\' is not a type");
         }
-        if (static_cast<TypeNode*>(tynode.get())->isFunction()) {
-            gst->functions[n] = std::shared_ptr<Function>();
+        if (static_cast<TypeNode*>(tynode)->isFunction()) {
+            gst->functions[id] = std::shared_ptr<Function>();
         }
         else {
-            gst->variables[n] = std::shared_ptr<Variable>();
+            gst->variables[id] = std::shared_ptr<Variable>();
         }
 
         if (!getType(tnode)) {
@@ -142,15 +149,16 @@ namespace dmp {
         return ( type->isFunction() ? getFunction(ident, storage, type) : getGlobalVar(ident, storage, type) );
     }
 
-    bool Translator::getGlobalRef(const std::shared_ptr<Identifier>& ident) {
+    bool Translator::getGlobalRef(Identifier* ident) {
 
         const auto& n = ident->name;
-        const auto& defn = ast->definitions[n];
+        auto id = ident->id;
+        const auto& defn = ast->definitions[id];
         const auto& def = defn->def;
 
         // I can't think of a better way to 'mark' the reference than declaring it both as a variable and a function
-        gst->functions[n] = std::shared_ptr<Function>();
-        gst->variables[n] = std::shared_ptr<Variable>();
+        gst->functions[id] = std::shared_ptr<Function>();
+        gst->variables[id] = std::shared_ptr<Variable>();
 
         if (!getValue(def)) {
             return error(def, "Unable to determine the referee of global reference " + n);
@@ -162,38 +170,38 @@ namespace dmp {
         if (referee->isVar()) {
             auto var = std::make_shared<Variable>(STORAGE_REFERENCE, n, referee->type);
             var->llvm_value = static_cast<Variable*>(referee.get())->ptr();
-            result = gst->variables[n] = var;
-            gst->functions.erase(gst->functions.find(n));
+            result = gst->variables[id] = var;
+            gst->functions.erase(id);
         }
         else {
             auto func = std::make_shared<Function>(STORAGE_REFERENCE, n, referee->type);
             func->llvm_value = static_cast<Function*>(referee.get())->ptr();
-            result = gst->functions[n] = func;
-            gst->variables.erase(gst->variables.find(n));
+            result = gst->functions[id] = func;
+            gst->variables.erase(id);
         }
 
         return success();
     }
 
-    bool Translator::literal(const std::shared_ptr<ExprNode>& expr) {
+    bool Translator::literal(ExprNode* expr) {
         if (expr->is == EXPR_INT) {
-            auto intnode = static_cast<IntNode*>(expr.get());
+            auto intnode = static_cast<IntNode*>(expr);
             result = std::make_shared<IntLiteral>(intnode->literal);
         }
         else if (expr->is == EXPR_BOOL) {
-            auto boolnode = static_cast<BoolNode*>(expr.get());
+            auto boolnode = static_cast<BoolNode*>(expr);
             result = std::make_shared<BoolLiteral>(boolnode->literal);
         }
         else if (expr->is == EXPR_REAL) {
-            auto realnode = static_cast<RealNode*>(expr.get());
+            auto realnode = static_cast<RealNode*>(expr);
             result = std::make_shared<RealLiteral>(realnode->literal);
         }
         else if (expr->is == EXPR_CHAR) {
-            auto charnode = static_cast<CharNode*>(expr.get());
+            auto charnode = static_cast<CharNode*>(expr);
             result = std::make_shared<CharLiteral>(charnode->literal);
         }
         else if (expr->is == EXPR_STRING) {
-            auto strnode = static_cast<StringNode*>(expr.get());
+            auto strnode = static_cast<StringNode*>(expr);
             result = std::make_shared<StringLiteral>(strnode->literal);
         }
         else {
@@ -202,7 +210,7 @@ namespace dmp {
         return success();
     }
 
-    bool Translator::unary(const std::shared_ptr<UnaryExprNode>& un) {
+    bool Translator::unary(UnaryExprNode* un) {
         if (un->op == UNARYOP_SIZE) {
             bool istype = false;
             if (!getValue(un->exp)) {
@@ -262,7 +270,7 @@ namespace dmp {
         return (result ? success() : error(un, err));
     }
 
-    bool Translator::recast(const std::shared_ptr<BinaryExprNode>& binary) {
+    bool Translator::recast(BinaryExprNode* binary) {
         if (!getType(binary->rhs)) {
             return error(binary, "Unable to obtain recast type");
         }
@@ -284,7 +292,7 @@ namespace dmp {
         return success();
     }
 
-    bool Translator::member(const std::shared_ptr<BinaryExprNode>& binary) {
+    bool Translator::member(BinaryExprNode* binary) {
         if (!getValue(binary->lhs)) {
             return error(binary, "Unable to evaluate the left side of the member operation");
         }
@@ -296,16 +304,16 @@ namespace dmp {
         if (!lhs->type->isStruct() && !lhs->type->isUnion()) {
             return error(binary, "Variable type for the member operation must be struct or union");
         }
-        auto memident = static_cast<Identifier*>(binary->rhs.get());
+        auto memident = static_cast<Identifier*>(binary->rhs);
         auto var = std::static_pointer_cast<Variable>(lhs);
-        result = BinaryOp::member(var, memident->name);
+        result = BinaryOp::member(var, memident->id);
         if (!result) {
             return error(binary, "No member called " + memident->name);
         }
         return success();
     }
 
-    bool Translator::element(const std::shared_ptr<BinaryExprNode>& binary) {
+    bool Translator::element(BinaryExprNode* binary) {
         if (!getValue(binary->lhs)) {
             return error(binary, "Unable to evaluate the left side of the element operation");
         }
@@ -374,15 +382,15 @@ namespace dmp {
         return success();
     }
 
-    bool Translator::binary(const std::shared_ptr<ExprNode>& expr) {
+    bool Translator::binary(ExprNode* expr) {
 
         uint16_t op;
         std::string opstr;
-        std::shared_ptr<Node> lhs_node;
-        std::shared_ptr<Node> rhs_node;
+        Node* lhs_node = nullptr;
+        Node* rhs_node = nullptr;
 
         if (expr->is == EXPR_BINARY) {
-            auto bin = std::static_pointer_cast<BinaryExprNode>(expr);
+            auto bin = static_cast<BinaryExprNode*>(expr);
             op = bin->op;
             switch (op) {
                 case BINARYOP_RECAST  : return recast(bin);
@@ -394,7 +402,7 @@ namespace dmp {
             rhs_node = bin->rhs;
         }
         else if (expr->is == EXPR_ASSIGN) {
-            auto assex = std::static_pointer_cast<AssignExprNode>(expr);
+            auto assex = static_cast<AssignExprNode*>(expr);
             op = assex->op;
             opstr = ExprNode::assopstring(op);
             lhs_node = assex->lhs;
@@ -424,7 +432,7 @@ namespace dmp {
                 return error(expr, "Operands of \'" + opstr + "\' operation must have boolean type");
             }
 
-            auto res = std::make_shared<Variable>(STORAGE_LOCAL, "", std::make_shared<PrimitiveType>(TYPE_BOOL));
+            auto res = std::make_shared<Variable>(STORAGE_LOCAL, "", TheTypeContext->primitive(TYPE_BOOL));
             res->declare();
             BinaryOp::assign(res, lhs);
 
@@ -566,12 +574,12 @@ namespace dmp {
         return success();
     }
 
-    bool Translator::assign(const std::shared_ptr<Variable>& var, const std::shared_ptr<Node>& rval) {
+    bool Translator::assign(const std::shared_ptr<Variable>& var, Node* rval) {
 
         if (rval->kind == NODE_EXPRNODE) {
-            auto expr = static_cast<ExprNode*>(rval.get());
+            auto expr = static_cast<ExprNode*>(rval);
             if (expr->is == EXPR_CALL) {
-                return call(std::static_pointer_cast<CallExprNode>(rval), var);
+                return call(static_cast<CallExprNode*>(rval), var);
             }
         }
 
@@ -1,3 +1,4 @@
+#include <llvm/IR/GlobalVariable.h>
 #include <Common/Globals.h>
 #include <Translator/Translator.h>
 #include <AST/NameNode.h>
@@ -7,27 +8,29 @@
 #include <IR/BinaryOp.h>
 #include <IR/Variable.h>
 #include <IR/Literal.h>
+#include <IR/LST.h>
 
 namespace dmp {
 
-    bool Translator::getGlobalVar(const std::shared_ptr<Identifier>& ident, uint16_t storage, const std::shared_ptr<Type>& type) {
+    bool Translator::getGlobalVar(Identifier* ident, uint16_t storage, const std::shared_ptr<Type>& type) {
 
         const auto& n = ident->name;
+        auto id = ident->id;
         if (n == "main") {
             return error("\'main\' can only ne defined as a function");
         }
 
-        std::shared_ptr<Node> defn;
-        if (ast->declarations.find(n) != ast->declarations.end()) {
-            defn = std::make_shared<NullInit>(false);
+        Node* defn = nullptr;
+        if (ast->declarations.contains(id)) {
+            defn = ast->make<NullInit>(false);
         }
         else {
-            defn = ast->definitions[n];
+            defn = ast->definitions[id];
         }
 
         std::shared_ptr<Variable> var;
         if (!type) {
-            auto def = static_cast<DefineStatement*>(defn.get())->def;
+            auto def = static_cast<DefineStatement*>(defn)->def;
             if (!getValue(def)) {
                 return error(def, "Unable to determine the initial value of global " + n);
             }
@@ -41,29 +44,33 @@ namespace dmp {
         }
         else {
             var = std::make_shared<Variable>(storage, n, type);
+            auto align = (ast->definitions.contains(id) ? ast->definitions[id]->align : nullptr);
+            if (align && !getAlignment(align, var->explicit_align)) {
+                return error();
+            }
             if (!initGlobal(var, defn)) {
                 return error();
             }
         }
-        if (ast->declarations.find(n) != ast->declarations.end()) {
+        if (ast->declarations.contains(id)) {
             var->initExternal();
         }
-        result = gst->variables[n] = var;
+        result = gst->variables[id] = var;
         return success();
     }
 
-    bool Translator::initGlobal(const std::shared_ptr<Variable>& var, const std::shared_ptr<Node>& rval) {
+    bool Translator::initGlobal(const std::shared_ptr<Variable>& var, Node* rval) {
 
         if (rval->kind == NODE_STATEMENT) {
-            auto stmt = static_cast<Statement*>(rval.get());
+            auto stmt = static_cast<Statement*>(rval);
             if (stmt->is != STATEMENT_DEFINE) {
                 return error(stmt, "Invalid variable definition");
             }
-            auto defn = std::static_pointer_cast<DefineStatement>(rval);
+            auto defn = static_cast<DefineStatement*>(rval);
             auto def = defn->def;
             if (def->kind == NODE_INITIALIZER) {
                 if (var->type->isPrimitive() || var->type->isPtr()) {
-                    auto init = std::static_pointer_cast<Initializer>(def);
+                    auto init = static_cast<Initializer*>(def);
                     if (init->elements.size() != 1 || init->elements[0].is != INIT_UNTAGGED) {
                         return error(def, "Invalid variable initializer");
                     }
@@ -74,7 +81,7 @@ namespace dmp {
         }
         else if (rval->kind == NODE_NULLINIT) {
             var->declare();
-            if (static_cast<NullInit*>(rval.get())->zero) {
+            if (static_cast<NullInit*>(rval)->zero) {
                 var->init();
             }
         }
@@ -92,18 +99,18 @@ namespace dmp {
         return success();
     }
 
-    bool Translator::initLocal(const std::shared_ptr<Variable>& var, const std::shared_ptr<Node>& rval) {
+    bool Translator::initLocal(const std::shared_ptr<Variable>& var, Node* rval) {
 
         if (rval->kind == NODE_STATEMENT) {
-            auto stmt = static_cast<Statement*>(rval.get());
+            auto stmt = static_cast<Statement*>(rval);
             if (stmt->is != STATEMENT_DEFINE) {
                 return error(stmt, "Invalid variable definition");
             }
-            auto defn = std::static_pointer_cast<DefineStatement>(rval);
+            auto defn = static_cast<DefineStatement*>(rval);
             auto def = defn->def;
             if (def->kind == NODE_INITIALIZER) {
                 if (var->type->isPrimitive() || var->type->isPtr()) {
-                    auto init = std::static_pointer_cast<Initializer>(def);
+                    auto init = static_cast<Initializer*>(def);
                     if (init->elements.size() != 1 || init->elements[0].is != INIT_UNTAGGED) {
                         return error(def, "Invalid variable initializer");
                     }
@@ -114,19 +121,24 @@ namespace dmp {
         }
 
         else if (rval->kind == NODE_NULLINIT) {
-            var->declare();
-            if (static_cast<NullInit*>(rval.get())->zero) {
+            if (static_cast<NullInit*>(rval)->zero) {
                 var->init();
             }
             result = var;
             return success();
         }
         else if (rval->kind == NODE_INITIALIZER) {
-            var->declare();
             if (!var->type->isCompound()) {
                 return error(rval, "Only compound types can be initialized using an initializer");
             }
-            auto in = std::static_pointer_cast<Initializer>(rval);
+            auto in = static_cast<Initializer*>(rval);
+            if (!var->type->isUnion() && var->type->size() >= const_init_size && isConstInitializer(in)) {
+                auto nerrors = errors.size();
+                if (initLocalConst(var, in)) {
+                    return success();
+                }
+                errors.erase(errors.begin() + nerrors, errors.end());
+            }
             if (var->type->isArray()) {
                 return initLocalArray(var, in);
             }
@@ -136,7 +148,6 @@ namespace dmp {
             return initLocalUnion(var, in);
         }
         else if (rval->kind == NODE_EXPRNODE || rval->kind == NODE_IDENTIFIER) {
-            var->declare();
             return assign(var, rval);
         }
         else {
@@ -144,7 +155,7 @@ namespace dmp {
         }
     }
 
-    bool Translator::initLocalArray(const std::shared_ptr<Variable>& var, const std::shared_ptr<Initializer>& in) {
+    bool Translator::initLocalArray(const std::shared_ptr<Variable>& var, Initializer* in) {
         std::size_t idx = -1;
         for (const auto& ie : in->elements) { 
             if (!getArrayTypeIndex(std::static_pointer_cast<ArrayType>(var->type), ie, idx)) {
@@ -164,7 +175,7 @@ namespace dmp {
         return success();
     }
 
-    bool Translator::initLocalStruct(const std::shared_ptr<Variable>& var, const std::shared_ptr<Initializer>& in) {
+    bool Translator::initLocalStruct(const std::shared_ptr<Variable>& var, Initializer* in) {
         std::size_t idx = -1;
         for (const auto& ie : in->elements) {
             if (!getStructTypeIndex(std::static_pointer_cast<StructType>(var->type), ie, idx)) {
@@ -184,7 +195,7 @@ namespace dmp {
         return success();
     }
 
-    bool Translator::initLocalUnion(const std::shared_ptr<Variable>& var, const std::shared_ptr<Initializer>& in) {
+    bool Translator::initLocalUnion(const std::shared_ptr<Variable>& var, Initializer* in) {
         auto ty = static_cast<UnionType*>(var->type.get());
         if (in->elements.size() > 1) {
             return error(in, "Union initializer with more than one element");
@@ -206,13 +217,143 @@ namespace dmp {
         return success();
     }
 
-    bool Translator::initConst(const std::shared_ptr<Type>& ty, const std::shared_ptr<Node>& nd) {
+    /*
+
+    Initialization of a local array or struct whose initializer is made only of constants
+
+    Rather than storing every element on each execution of the definition, the elements are evaluated once as
+    constants. If most of them are zero, the variable is cleared and only the non-zero elements are stored.
+    Otherwise the whole value is placed in a private, unnamed_addr constant global and copied into the variable.
+
+    */
+
+    bool Translator::initLocalConst(const std::shared_ptr<Variable>& var, Initializer* in) {
+
+        std::map<std::size_t, std::shared_ptr<Value> > cmap;
+        std::vector<llvm::Constant*> elements;
+        if (var->type->isArray()) {
+            auto ty = std::static_pointer_cast<ArrayType>(var->type);
+            if (!getArrayConsts(ty, in, cmap)) {
+                return error();
+            }
+            elements.resize(ty->nelements, llvm::Constant::getNullValue(ty->array_of->llvm_type));
+        }
+        else {
+            auto ty = std::static_pointer_cast<StructType>(var->type);
+            if (!getStructConsts(ty, in, cmap)) {
+                return error();
+            }
+            for (const auto& m : ty->members) {
+                elements.push_back(llvm::Constant::getNullValue(m.type->llvm_type));
+            }
+            if (ty->explicit_align > 1) {
+                elements.push_back(llvm::Constant::getNullValue(llvm::cast<llvm::StructType>(ty->llvm_type)->elements().back()));
+            }
+        }
+
+        std::vector<std::size_t> nonzero;
+        for (const auto& icmap : cmap) {
+            auto idx = icmap.first;
+            auto c = Variable::conformConst(llvm::cast<llvm::Constant>(icmap.second->val()), elements[idx]->getType());
+            if (!c) {
+                return error();
+            }
+            elements[idx] = c;
+            if (!c->isNullValue()) {
+                nonzero.push_back(idx);
+            }
+        }
+
+        if (nonzero.size() * 4 <= elements.size()) {
+            var->init();
+            for (auto idx : nonzero) {
+                auto iv = std::static_pointer_cast<Variable>(BinaryOp::element(var, makePooled<IntLiteral>(idx)));
+                TheBuilder->CreateStore(elements[idx], iv->ptr());
+            }
+            result = var;
+            return success();
+        }
+
+        llvm::Constant* c = nullptr;
+        if (var->type->isArray()) {
+            c = llvm::ConstantArray::get(llvm::cast<llvm::ArrayType>(var->type->llvm_type), elements);
+        }
+        else {
+            c = llvm::ConstantStruct::get(llvm::cast<llvm::StructType>(var->type->llvm_type), elements);
+        }
+        auto gv = new llvm::GlobalVariable(*TheModule, c->getType(), true, llvm::GlobalValue::PrivateLinkage, c, "");
+        gv->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+        gv->setAlignment(llvm::Align(var->type->alignment()));
+
+        auto src = makePooled<Variable>(STORAGE_INTERNAL, "", var->type);
+        src->llvm_value = gv;
+        MemoryOp::memcpy(var, src);
+
+        result = var;
+        return success();
+    }
+
+    /*
+    Check, without translating anything, whether an initializer only contains literals, representations
+    and operations on them -- i.e. whether it can be evaluated without emitting any instructions
+    */
+    bool Translator::isConstInitializer(Node* nd) {
+
+        if (nd->kind == NODE_INITIALIZER) {
+            for (const auto& ie : static_cast<Initializer*>(nd)->elements) {
+                if (!isConstInitializer(ie.value)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        if (nd->kind == NODE_IDENTIFIER) {
+            auto id = static_cast<Identifier*>(nd)->id;
+            if (currentFunction && currentFunction->lst->getInstance(id)) {
+                return false;
+            }
+            return gst->constants.contains(id) && gst->constants[id] && gst->constants[id]->isConst();
+        }
+
+        if (nd->kind != NODE_EXPRNODE) {
+            return false;
+        }
+
+        auto expr = static_cast<ExprNode*>(nd);
+        if (expr->isLiteralNode()) {
+            return true;
+        }
+        if (expr->is == EXPR_UNARY) {
+            auto un = static_cast<UnaryExprNode*>(nd);
+            if (un->op == UNARYOP_SIZE) {
+                return true;
+            }
+            if (un->op == UNARYOP_ADDRESS || un->op == UNARYOP_DEREFERENCE) {
+                return false;
+            }
+            return isConstInitializer(un->exp);
+        }
+        if (expr->is == EXPR_BINARY) {
+            auto bn = static_cast<BinaryExprNode*>(nd);
+            if (bn->op == BINARYOP_RECAST) {
+                return isConstInitializer(bn->lhs);
+            }
+            if (bn->op == BINARYOP_MEMBER || bn->op == BINARYOP_ELEMENT) {
+                return false;
+            }
+            return isConstInitializer(bn->lhs) && isConstInitializer(bn->rhs);
+        }
+        return false;
+    }
+
+    bool Translator::initConst(const std::shared_ptr<Type>& ty, Node* nd) {
 
         if (ty->isCompound()) {
             if (nd->kind != NODE_INITIALIZER) {
                 return error(nd, "Initializer needed for compound type");
             }
-            auto in = std::static_pointer_cast<Initializer>(nd);
+            auto in = static_cast<Initializer*>(nd);
             if (ty->isArray()) {
                 return initArrayConst(std::static_pointer_cast<ArrayType>(ty), in);
             }
@@ -228,16 +369,13 @@ namespace dmp {
         return initSimpleConst(ty, nd);
     }
 
-    bool Translator::initSimpleConst(const std::shared_ptr<Type>& ty, const std::shared_ptr<Node>& nd) {
+    bool Translator::initSimpleConst(const std::shared_ptr<Type>& ty, Node* nd) {
 
         if (!getValue(nd)) {
             return error(nd, "Unable to obtain initial value");
         }
 
-        auto t = ty;
-        if (ty->isPtr()) {
-            t = std::make_shared<PointerType>(static_cast<PointerType*>(ty.get())->points_to);
-        }
+        auto t = PointerType::directType(ty);
 
         auto ex = std::static_pointer_cast<Value>(result);
         ex = BinaryOp::recastImplicit(ex, t);
@@ -252,32 +390,49 @@ namespace dmp {
         return success();
     }
 
-    bool Translator::initArrayConst(const std::shared_ptr<ArrayType>& ty, const std::shared_ptr<Initializer>& in) {
+    bool Translator::initArrayConst(const std::shared_ptr<ArrayType>& ty, Initializer* in) {
 
         auto t = std::static_pointer_cast<ArrayType>(ty->clone());
 
-        std::size_t idx = -1;
         std::map<std::size_t, std::shared_ptr<Value> > cmap;
+        if (!getArrayConsts(t, in, cmap)) {
+            return error();
+        }
+
+        result = ArrayType::initConst(t, cmap);
+        return success();
+    }
+
+    bool Translator::initStructConst(const std::shared_ptr<StructType>& ty, Initializer* in) {
+
+        auto t = std::static_pointer_cast<StructType>(ty->clone());
+
+        std::map<std::size_t, std::shared_ptr<Value> > cmap;
+        if (!getStructConsts(ty, in, cmap)) {
+            return error();
+        }
+        result = StructType::initConst(t, cmap);
+        return success();
+    }
+
+    bool Translator::getArrayConsts(const std::shared_ptr<ArrayType>& ty, Initializer* in, std::map<std::size_t, std::shared_ptr<Value> >& cmap) {
+
+        std::size_t idx = -1;
         for (const auto& ie : in->elements) {
             if (!getArrayTypeIndex(ty, ie, idx)) {
                 return error();
             }
-            if (!initConst(t->array_of, ie.value)) {
+            if (!initConst(ty->array_of, ie.value)) {
                 return error(ie.value, "Unable to initialize array element at index " + std::to_string(idx));
             }
             cmap[idx] = std::static_pointer_cast<Value>(result);
         }
-
-        result = ArrayType::initConst(t, cmap);
         return success();
     }
 
-    bool Translator::initStructConst(const std::shared_ptr<StructType>& ty, const std::shared_ptr<Initializer>& in) {
-
-        auto t = std::static_pointer_cast<StructType>(ty->clone());
+    bool Translator::getStructConsts(const std::shared_ptr<StructType>& ty, Initializer* in, std::map<std::size_t, std::shared_ptr<Value> >& cmap) {
 
         std::size_t idx = -1;
-        std::map<std::size_t, std::shared_ptr<Value> > cmap;
         for (const auto& ie : in->elements) {
             if (!getStructTypeIndex(ty, ie, idx)) {
                 return error();
@@ -288,11 +443,10 @@ namespace dmp {
             }
             cmap[idx] = std::static_pointer_cast<Value>(result);
         }
-        result = StructType::initConst(t, cmap);
         return success();
     }
 
-    bool Translator::initUnionConst(const std::shared_ptr<UnionType>& ty, const std::shared_ptr<Initializer>& in) {
+    bool Translator::initUnionConst(const std::shared_ptr<UnionType>& ty, Initializer* in) {
 
         auto t = std::static_pointer_cast<UnionType>(ty->clone());
 
@@ -345,10 +499,10 @@ namespace dmp {
                 if (ie.tag->kind != NODE_IDENTIFIER) {
                     return error(ie.tag, "Unexpected struct initializer label");
                 }
-                auto ident = static_cast<const Identifier*>(ie.tag.get());
+                auto ident = static_cast<const Identifier*>(ie.tag);
                 bool found = false;
                 for (std::size_t j = 0; j < t->members.size(); j++) {
-                    if (t->members[j].name && t->members[j].name->name == ident->name) {
+                    if (t->members[j].name && t->members[j].name->id == ident->id) {
                         idx = j;
                         found = true;
                         break;
@@ -388,10 +542,10 @@ namespace dmp {
             if (ie.tag->kind != NODE_IDENTIFIER) {
                 return error(ie.tag, "Unexpected union initializer label");
             }
-            auto ident = static_cast<const Identifier*>(ie.tag.get());
+            auto ident = static_cast<const Identifier*>(ie.tag);
             bool found = false;
             for (std::size_t j = 0; j < t->members.size(); j++) {
-                if (t->members[j].name && t->members[j].name->name == ident->name) {
+                if (t->members[j].name && t->members[j].name->id == ident->id) {
                     idx = j;
                     found = true;
                     break;
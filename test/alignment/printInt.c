@@ -0,0 +1,7 @@
+#include <stdio.h>
+
+void printInt(int i) {
+
+    printf("%d", i);
+
+}
@@ -0,0 +1,7 @@
+#include <stdio.h>
+
+void printChar(char c) {
+
+    fputc(c, stdout);
+
+}